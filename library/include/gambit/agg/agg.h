@@ -30,6 +30,7 @@
 #include <iterator>
 #include "proj_func.h"
 #include "trie_map.h"
+#include "flat_map.h"
 
 namespace Gambit {
 
@@ -59,7 +60,7 @@ typedef trie_map<AggNumber> aggpayoff;
 
 
 //data struct for prob distribution over configurations:
-typedef trie_map<AggNumber> aggdistrib;
+typedef flat_map<AggNumber> aggdistrib;
 
 //types of input formats for payoff func
 typedef enum{COMPLETE,MAPPING,ADDITIVE} payofftype; 
@@ -101,6 +102,9 @@ std::vector<projtype>& projTypes, int seed, bool int_payoffs=false, int int_fact
    std::vector<aggdistrib> &P,
       std::vector<aggpayoff>& payoffs);
 
+  //copy constructor: the copy owns its own projection functions,
+  //and starts with empty caches of jacobian entries and distributions
+  AGG(const AGG& other);
 
   //agg(const agg& other, bool completeGraph = false);
 
@@ -118,6 +122,12 @@ std::vector<projtype>& projTypes, int seed, bool int_payoffs=false, int int_fact
       for (size_t i=0;i<projectionTypes.size();++i){
         delete projectionTypes[i];
       }
+      //the functions projecting neighbors which are action nodes are
+      //allocated for each neighbor; the others are projectionTypes
+      for (size_t i=0; i<projFunctions.size(); ++i)
+	  for (size_t j=0;j<projFunctions[i].size(); ++j)
+	      if (neighbors[i][j]<numActionNodes)
+		  delete projFunctions[i][j];
   }
 
 
@@ -135,6 +145,7 @@ std::vector<projtype>& projTypes, int seed, bool int_payoffs=false, int int_fact
   inline int getNumKSymActions(int i){return uniqueActionSets[i].size();}
   inline int getNumPlayerClasses(){return playerClasses.size();}
   inline const PlayerSet& getPlayerClass(int cls){return playerClasses.at(cls);}
+  inline int getClassOfPlayer(int player){return player2Class.at(player);}
   inline int firstKSymAction(int i){return kSymStrategyOffset[i];}
   inline int lastKSymAction(int i){return kSymStrategyOffset[i+1];}
 
@@ -276,6 +287,14 @@ private:
   //cache of jacobian entries.
   trie_map<AggNumber> cache;
 
+  //foreach action node s, the distribution induced at s by the
+  //strategies of all players in fullProfile, if fullPValid[s]
+  std::vector<aggdistrib> fullP;
+  std::vector<bool> fullPValid;
+
+  //the strategy profile for which fullP is kept
+  StrategyProfile fullProfile;
+
   //the unique action sets
   std::vector<ActionSet> uniqueActionSets;
 
@@ -337,6 +356,12 @@ private:
 
   //private methods:
   void computeP(int player, int act, int player2=-1,int act2=-1);
+  void computeOthersP(int player, int act, const AggNumber *s);
+  bool divideFullP(int Node, int player, const AggNumber *s);
+  static bool divide(aggdistrib &dest, const aggdistrib &P,
+		     const aggdistrib &d, int numNei);
+  void getPayoffs(AggNumberVector &dest, int player, const AggNumber *s,
+		  bool supportOnly);
   void doProjection(int Node,const StrategyProfile& s){
 	  doProjection (Node, &(const_cast<StrategyProfile &>(s)[0]));
   }
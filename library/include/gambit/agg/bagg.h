@@ -67,6 +67,9 @@ public:
     std::vector<std::vector<std::vector<int > > > &ta2a,
     AGG* aggPtr);
 
+  //copy constructor: the copy has its own copy of the underlying AGG
+  BAGG(const BAGG& other);
+
   ~BAGG(){
     delete[] typeOffset;
     delete[] strategyOffset;
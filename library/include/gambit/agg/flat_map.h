@@ -0,0 +1,300 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/include/gambit/agg/flat_map.h
+// Flat hash map from configurations, with the interface of trie_map
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef GAMBIT_AGG_FLATMAP_H
+#define GAMBIT_AGG_FLATMAP_H
+
+//Mapping from vector of ints to type V, used for the distributions over
+//configurations that are rebuilt many times during payoff computations.
+//The keys are packed into blocks of an arena, and the entries are kept
+//in an array in order of insertion, indexed by an open-addressing hash
+//table.  reset() empties the map in constant time, keeping the arena,
+//the entries and the table for reuse, so that once a map has grown to
+//the size of the distributions it holds, rebuilding it allocates nothing.
+//
+//Unlike trie_map, find() matches keys exactly, traversal is in the order
+//of insertion, and inserting may invalidate iterators.
+
+#include <math.h>
+#include <algorithm>
+#include <vector>
+#include <iterator>
+#include <iostream>
+
+#include "proj_func.h"
+#include "trie_map.h"
+
+namespace Gambit {
+
+namespace agg {
+
+template <class V> class flat_map;
+
+template <class V>
+std::ostream& operator<< (std::ostream& s, const flat_map<V>& t);
+
+template <class V> class flat_map {
+public:
+  //typedefs
+  typedef std::vector<int>          key_type;
+  typedef std::pair<std::vector<int>, V> value_type;
+  typedef unsigned int  size_type;
+
+  //a key, as stored in the arena
+  class key_ref {
+  public:
+    typedef const int *const_iterator;
+
+    key_ref() : m_data(0), m_len(0) { }
+    key_ref(const int *p_data, size_t p_len) : m_data(p_data), m_len(p_len) { }
+
+    const int *begin() const { return m_data; }
+    const int *end() const { return m_data + m_len; }
+    size_t size() const { return m_len; }
+    int operator[](size_t i) const { return m_data[i]; }
+    operator std::vector<int>() const { return std::vector<int>(begin(), end()); }
+    bool operator==(const std::vector<int> &k) const
+    { return k.size() == m_len && std::equal(begin(), end(), k.begin()); }
+    bool operator!=(const std::vector<int> &k) const { return !(*this == k); }
+
+  private:
+    const int *m_data;
+    size_t m_len;
+  };
+
+  struct entry {
+    key_ref first;
+    V second;
+    unsigned int hash;
+  };
+
+  typedef entry *iterator;
+  typedef const entry *const_iterator;
+
+  //friends
+  friend std::ostream& operator<< <V>(std::ostream& s, const flat_map<V>& t);
+
+  //constructors
+  flat_map() : m_size(0), m_stamp(1), m_block(0), m_offset(0) { }
+  flat_map(const flat_map<V>& other);
+
+  //destructor
+  ~flat_map() { clear(); }
+
+  //assignment; the entries are copied in order
+  flat_map<V>& operator=(const flat_map<V>& other);
+  //for compatibility with trie_map, whose assignment reverses the order
+  void assign_in_order(const flat_map<V>& other) { *this = other; }
+
+  void swap(flat_map<V>& other);
+
+  size_type size() const { return m_size; }
+  bool empty() const { return m_size == 0; }
+  iterator begin() { return (m_entries.empty()) ? 0 : &m_entries[0]; }
+  iterator end() { return begin() + m_size; }
+  const_iterator begin() const { return (m_entries.empty()) ? 0 : &m_entries[0]; }
+  const_iterator end() const { return begin() + m_size; }
+
+  //insert: same interface as in STL map
+  std::pair<iterator, bool> insert(const value_type& x)
+  {
+    unsigned int h = Hash(Data(x.first), x.first.size());
+    int i = Lookup(Data(x.first), x.first.size(), h);
+    if (i >= 0) {
+      return std::pair<iterator, bool>(begin() + i, false);
+    }
+    return std::pair<iterator, bool>(Append(Data(x.first), x.first.size(),
+					    h, x.second), true);
+  }
+
+  //insert or add
+  flat_map<V>& operator+=(const value_type& x)
+  { Add(Data(x.first), x.first.size(), x.second); return *this; }
+
+  //exact matching
+  iterator find(const key_type& k)
+  {
+    int i = Lookup(Data(k), k.size(), Hash(Data(k), k.size()));
+    return (i >= 0) ? begin() + i : end();
+  }
+  const_iterator find(const key_type& k) const
+  {
+    int i = Lookup(Data(k), k.size(), Hash(Data(k), k.size()));
+    return (i >= 0) ? begin() + i : end();
+  }
+
+  //number of elements with key k: returns 1 or 0
+  size_type count(const key_type& k) const
+  { return Lookup(Data(k), k.size(), Hash(Data(k), k.size())) >= 0; }
+
+  //release all storage
+  void clear();
+
+  //remove all entries, keeping the storage for reuse
+  void reset()
+  {
+    m_size = 0;
+    m_block = 0;
+    m_offset = 0;
+    if (++m_stamp == 0) {
+      std::fill(m_stamps.begin(), m_stamps.end(), 0);
+      m_stamp = 1;
+    }
+  }
+
+  void print_in_order() const { std::cout << *this; }
+
+  //polynomial multiplication of t1 and t2, store the result in self
+  void multiply(const flat_map<V>& t1, const flat_map<V>& t2, size_t keylen,
+		std::vector<proj_func*>& f);
+
+  //multiply in-place. other should not be the same object as self.
+  void multiply(const flat_map<V>& other, size_t keylen,
+		std::vector<proj_func*>& f);
+
+  //squaring
+  void square(flat_map<V>& dest, size_t keylen,
+	      std::vector<proj_func*>& f) const;
+
+  void power(size_t p, flat_map<V> &dest, flat_map<V> &scratch,
+	     size_t keylen, std::vector<proj_func*> &f) const
+  {
+    if (p == 1) {
+      dest = *this;
+      return;
+    }
+    square(dest, keylen, f);
+    p -= 2;
+    if (p > 1) scratch = dest;
+    while (p > 0) {
+      if (p == 1) {
+	dest.multiply(*this, keylen, f);
+	return;
+      }
+      dest.multiply(scratch, keylen, f);
+      p -= 2;
+    }
+  }
+
+  //inner product with a payoff function
+  V inner_prod(trie_map<V>& other, V init = (V)(0)) const;
+
+  //first apply the action x, then inner prod
+  V inner_prod(const std::vector<int>& x, size_t keylen,
+	       std::vector<proj_func*>& f,
+	       trie_map<V>& other, V init = (V)(0)) const;
+
+  //polynomial division
+  flat_map<V>& operator/=(const std::vector<V>& denom);
+
+private:
+  //the entries, of which the first m_size are in use
+  std::vector<entry> m_entries;
+  size_type m_size;
+
+  //hash table of indices into m_entries; a slot is in use if its
+  //stamp is the current one
+  std::vector<unsigned int> m_slots, m_stamps;
+  unsigned int m_stamp;
+
+  //the arena holding the keys
+  std::vector<int *> m_blocks;
+  std::vector<size_t> m_blockSizes;
+  size_t m_block, m_offset;
+
+  //a buffer for building keys
+  std::vector<int> m_key;
+  //a copy of the entries, used by in-place operations
+  std::vector<int> m_spareKeys;
+  std::vector<V> m_spareValues;
+
+  static const double THRESH;
+
+  static const int *Data(const std::vector<int> &p_key)
+  { return (p_key.empty()) ? 0 : &p_key[0]; }
+
+  static unsigned int Hash(const int *p_key, size_t p_len)
+  {
+    unsigned int h = 2166136261u;
+    for (size_t i = 0; i < p_len; i++) {
+      h = (h ^ (unsigned int) p_key[i]) * 16777619u;
+    }
+    h ^= h >> 15;
+    h *= 0x2c1b3c6du;
+    return h ^ (h >> 12);
+  }
+
+  //returns the index of the entry with the key, or -1 if there is none
+  int Lookup(const int *p_key, size_t p_len, unsigned int p_hash) const
+  {
+    if (m_slots.empty()) return -1;
+    size_t mask = m_slots.size() - 1;
+    for (size_t s = p_hash & mask; m_stamps[s] == m_stamp; s = (s + 1) & mask) {
+      const entry &e = m_entries[m_slots[s]];
+      if (e.hash == p_hash && std::equal(p_key, p_key + p_len, e.first.begin())) {
+	return m_slots[s];
+      }
+    }
+    return -1;
+  }
+
+  void Add(const int *p_key, size_t p_len, const V &p_value)
+  {
+    unsigned int h = Hash(p_key, p_len);
+    int i = Lookup(p_key, p_len, h);
+    if (i >= 0) {
+      m_entries[i].second += p_value;
+    }
+    else {
+      Append(p_key, p_len, h, p_value);
+    }
+  }
+
+  //adds an entry whose key is known not to be present
+  iterator Append(const int *p_key, size_t p_len, unsigned int p_hash,
+		  const V &p_value);
+  int *Allocate(size_t p_len);
+  void Rehash(size_t p_slots);
+  //copies the entries to the spare arrays, and resets
+  void MoveToSpare(void);
+};
+
+template <class V> const double flat_map<V>::THRESH = 1e-12;
+
+template <class V>
+inline std::ostream& operator<< (std::ostream& s, const flat_map<V>& t)
+{
+  for (typename flat_map<V>::const_iterator p = t.begin(); p != t.end(); ++p) {
+    s << "[ ";
+    copy(p->first.begin(), p->first.end(), std::ostream_iterator<int>(s, " "));
+    s << "] " << p->second << std::endl;
+  }
+  return s;
+}
+
+}  // end namespace Gambit::agg
+
+}  // end namespace Gambit
+
+#include "flat_map.imp"
+
+#endif  // GAMBIT_AGG_FLATMAP_H
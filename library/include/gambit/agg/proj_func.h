@@ -90,6 +90,8 @@ struct proj_func{
 	}
 	virtual int operator()(int x,int y)   =0;
 	virtual int operator()(std::multiset<int>& s) =0;
+	//returns a new copy of this function
+	virtual proj_func* clone() const =0;
 	virtual void print (std::ostream& out){
 	  out<< Type;
 	  out<<" "<<Default<<" ";
@@ -103,6 +105,7 @@ struct proj_func_SUM: public proj_func {
     inline int operator() (int x,int y){return x+y;}
     inline int operator()(std::multiset<int>& s){return s.size();}
     void print (std::ostream& out){ out<<P_SUM<<std::endl;}
+    proj_func* clone() const {return new proj_func_SUM(*this);}
 };
 
 struct proj_func_SUM2: public proj_func{
@@ -115,12 +118,14 @@ struct proj_func_SUM2: public proj_func{
       }
       return res;
     }
+    proj_func* clone() const {return new proj_func_SUM2(*this);}
 };
 struct proj_func_EXIST: public proj_func{
     proj_func_EXIST() :proj_func(P_EXIST,0) {}
     inline int operator() (int x, int y) {return (x+y>0);}
     inline int operator() (std::multiset<int>& s){ return (s.size()>0);}
     void print(std::ostream& out){out<<P_EXIST<<std::endl;}
+    proj_func* clone() const {return new proj_func_EXIST(*this);}
 };
 struct proj_func_EXIST2: public proj_func{
     proj_func_EXIST2(std::istream& in, int S):proj_func(P_EXIST2,in,S){
@@ -143,6 +148,7 @@ struct proj_func_EXIST2: public proj_func{
       }
       return (res>0);
     }
+    proj_func* clone() const {return new proj_func_EXIST2(*this);}
 };
 struct proj_func_HIGH:public proj_func{
     proj_func_HIGH(int def): proj_func(P_HIGH,def) {}
@@ -156,6 +162,7 @@ struct proj_func_HIGH:public proj_func{
 	return *(s.rbegin());
     }
     void print(std::ostream& out){out<<P_HIGH<<std::endl;}
+    proj_func* clone() const {return new proj_func_HIGH(*this);}
 };
 struct proj_func_HIGH2: public proj_func{
     proj_func_HIGH2(std::istream& in, int S):proj_func(P_HIGH2,in,S){ }
@@ -173,6 +180,7 @@ struct proj_func_HIGH2: public proj_func{
       }
       return res;
     }
+    proj_func* clone() const {return new proj_func_HIGH2(*this);}
 };
 struct proj_func_LOW: public proj_func{
     proj_func_LOW(int def): proj_func(P_LOW,def) {}
@@ -186,6 +194,7 @@ struct proj_func_LOW: public proj_func{
 	return *(s.begin());
     }
     void print(std::ostream &out){out<<P_LOW <<std::endl;}
+    proj_func* clone() const {return new proj_func_LOW(*this);}
 };	
 struct proj_func_LOW2: public proj_func{
     proj_func_LOW2(std::istream &in, int S):proj_func(P_LOW2,in,S){ }
@@ -203,6 +212,7 @@ struct proj_func_LOW2: public proj_func{
       }
       return res;
     }
+    proj_func* clone() const {return new proj_func_LOW2(*this);}
 };
 
 typedef proj_func* projtype;
@@ -99,6 +99,11 @@ public:
   //assignment
   inline trie_map<V>& operator=( const trie_map<V>& other);
 
+  //replaces the contents with those of other in the same order.
+  //(The copy constructor and assignment insert each entry at the front,
+  //and so reverse the order.)
+  inline void assign_in_order(const trie_map<V>& other);
+
   inline void swap (trie_map<V>& other);
 
   inline size_type size() const {return data.size();}
@@ -194,8 +199,8 @@ public:
   void multiply (const trie_map<V>& t1,const trie_map<V>& t2,size_t keylen,
 	 std::vector<proj_func*>& f)
   {
-    static size_t i;
-    static std::pair<std::vector<int>, V> v;
+    size_t i;
+    std::pair<std::vector<int>, V> v;
     const_iterator p1,p2;
     //assert(this!=&t1 && this != &t2);
     v.first.resize(keylen);
@@ -219,7 +224,7 @@ public:
   void multiply_smart (const trie_map<V>& P_k_minus_1,const trie_map<V>& projectedStrat,size_t keylen,
                         std::vector<proj_func*>& f)
         {
-                static std::pair<std::vector<int>, V> v;
+                std::pair<std::vector<int>, V> v;
                 v.first.resize(keylen);
                 reset();
 
@@ -274,7 +279,7 @@ public:
 
   //squaring
   void square(trie_map<V>& dest, size_t keylen, std::vector<proj_func*>& f) const{
-    static std::pair<std::vector<int>, V> v;
+    std::pair<std::vector<int>, V> v;
     v.first.resize(keylen);
     //assert(this!=&dest);
     dest.reset();
@@ -293,8 +298,8 @@ public:
 
   //squaring in-place
   void square(size_t keylen, std::vector<proj_func*>& f){
-    static typename std::list<typename trie_map<V>::value_type>::iterator p1,p2;
-    static std::pair<std::vector<int>, V> v;
+    typename std::list<typename trie_map<V>::value_type>::iterator p1,p2;
+    std::pair<std::vector<int>, V> v;
     v.first.resize(keylen);
     std::list<typename trie_map<V>::value_type> data2;
     //data.swap(data2);
@@ -385,7 +390,7 @@ public:
   { 
     V result(init);
     V th(THRESH);
-    static iterator p2;
+    iterator p2;
     //V s(-1);
     for (const_iterator p=begin(); p!=end();++p)if((*p).second>(V)0){
       value_type y= *p;
@@ -23,6 +23,7 @@
 #ifndef LIBGAMBIT_BEHAV_H
 #define LIBGAMBIT_BEHAV_H
 
+#include <vector>
 #include "game.h"
 
 namespace Gambit {
@@ -36,6 +37,9 @@ protected:
   BehaviorSupportProfile m_support;
 
   mutable bool m_cacheValid;
+  // Information sets at which action probabilities have been written
+  // since the cached data were computed, by index of their subvector
+  mutable std::vector<int> m_dirtyInfosets;
 
   // structures for storing cached data: nodes
   mutable Vector<T> m_realizProbs, m_beliefs, m_nvals, m_bvals;
@@ -47,6 +51,9 @@ protected:
   // structures for storing cached data: actions
   mutable DVector<T> m_actionValues;   // aka conditional payoffs
   mutable DVector<T> m_gripe;
+  // Probabilities of all actions in the game, including those of chance
+  // and those not in the support, indexed as in CompiledGameTree
+  mutable std::vector<T> m_actionProbs;
 
   const T &ActionValue(const GameAction &act) const 
     { return m_actionValues(act->GetInfoset()->GetPlayer()->GetNumber(),
@@ -59,11 +66,20 @@ protected:
   
   /// @name Auxiliary functions for computation of interesting values
   //@{
-  void GetPayoff(GameTreeNodeRep *, const T &, int, T &) const;
+  void GetPayoff(const CompiledGameTree &, int, const T &, int, T &) const;
   
-  void ComputeSolutionDataPass2(const GameNode &node) const;
-  void ComputeSolutionDataPass1(const GameNode &node) const;
+  void ComputeActionProbs(const CompiledGameTree &, int) const;
+  void ComputeRealizProbs(const CompiledGameTree &, int,
+			  std::vector<int> *) const;
+  void ComputeNodeValue(const CompiledGameTree &, int) const;
+  void ComputeInfosetData(const CompiledGameTree &, int) const;
+  void UpdateSolutionData(void) const;
   void ComputeSolutionData(void) const;
+
+  /// Records a write to the action probabilities at the information set
+  void MarkDirty(int pl, int iset) const;
+  /// Records a write to the action probability at the index
+  void MarkDirtyIndex(int index) const;
   //@}
 
   /// @name Converting mixed strategies to behavior
@@ -122,11 +138,11 @@ public:
   const T &operator()(int a, int b, int c) const
     { return DVector<T>::operator()(a, b, c); }
   T &operator()(int a, int b, int c) 
-    { Invalidate();  return DVector<T>::operator()(a, b, c); }
+    { MarkDirty(a, b);  return DVector<T>::operator()(a, b, c); }
   const T &operator[](int a) const
     { return Array<T>::operator[](a); }
   T &operator[](int a)
-    { Invalidate();  return Array<T>::operator[](a); }
+    { MarkDirtyIndex(a);  return Array<T>::operator[](a); }
 
   MixedBehaviorProfile<T> &operator+=(const MixedBehaviorProfile<T> &x)
     { Invalidate();  DVector<T>::operator+=(x);  return *this; }
@@ -141,7 +157,8 @@ public:
   /// @name Initialization, validation
   //@{
   /// Force recomputation of stored quantities
-  void Invalidate(void) const { m_cacheValid = false; }
+  void Invalidate(void) const
+    { m_cacheValid = false;  m_dirtyInfosets.clear(); }
   /// Set the profile to the centroid
   void SetCentroid(void);
   /// Set the behavior at any undefined information set to the centroid
@@ -150,15 +167,21 @@ public:
   void Normalize(void);
   /// Generate a random behavior strategy profile according to the uniform distribution
   void Randomize(void);
+  /// Generate a random behavior strategy profile according to the uniform distribution,
+  /// drawing from the specified generator
+  void Randomize(RandomGenerator &);
   /// Generate a random behavior strategy profile according to the uniform distribution
   /// on a grid with spacing p_denom
   void Randomize(int p_denom);
+  /// Generate a random behavior strategy profile according to the uniform distribution
+  /// on a grid with spacing p_denom, drawing from the specified generator
+  void Randomize(int p_denom, RandomGenerator &);
   //@}
 
   /// @name General data access
   //@{
   int Length(void) const { return Array<T>::Length(); }
-  Game GetGame(void) const { return m_support.GetGame(); }
+  const Game &GetGame(void) const { return m_support.GetGame(); }
   const BehaviorSupportProfile &GetSupport(void) const { return m_support; }
   
   bool IsDefinedAt(GameInfoset p_infoset) const;
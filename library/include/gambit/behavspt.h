@@ -70,7 +70,7 @@ public:
   /// @name General information
   //@{
   /// Returns the game on which the support is defined.
-  Game GetGame(void) const { return m_efg; }
+  const Game &GetGame(void) const { return m_efg; }
 
   /// Returns the number of actions in the information set
   int NumActions(const GameInfoset &p_infoset) const
@@ -82,13 +82,21 @@ public:
   PVector<int> NumActions(void) const;
 
   /// Returns the action at the specified position in the support
-  GameAction GetAction(const GameInfoset &p_infoset, int p_act) const
+  const GameAction &GetAction(const GameInfoset &p_infoset, int p_act) const
   { return m_actions[p_infoset->GetPlayer()->GetNumber()][p_infoset->GetNumber()][p_act]; }
-  GameAction GetAction(int pl, int iset, int act) const
+  const GameAction &GetAction(int pl, int iset, int act) const
   { return m_actions[pl][iset][act]; }
 
   /// Returns the position of the action in the support. 
   int GetIndex(const GameAction &) const;
+  /// Returns the position of the action at information set (pl, iset)
+  /// in the support, or zero if it is not in the support
+  int GetIndex(int pl, int iset, const GameActionRep *p_action) const
+  { const Array<GameAction> &actions = m_actions[pl][iset];
+    for (int i = 1; i <= actions.Length(); i++) {
+      if (actions[i] == p_action) return i;
+    }
+    return 0; }
 
   /// Returns whether the action is in the support.
   bool Contains(const GameAction &p_action) const
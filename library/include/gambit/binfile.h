@@ -0,0 +1,126 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/include/gambit/binfile.h
+// Encoding and decoding of binary game savefiles
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_BINFILE_H
+#define LIBGAMBIT_BINFILE_H
+
+#include <map>
+#include <vector>
+#include "game.h"
+
+namespace Gambit {
+
+//
+// A binary savefile consists of
+//   * a header: the eight-byte signature "GAMBITBF", then 32-bit words
+//     giving the format version, a byte-order mark, and the kind of game;
+//   * the string table: a count, then each string as a length followed
+//     by its bytes;
+//   * the value table: a count, then each distinct number as the index
+//     of its text in the string table, its double-precision value, and
+//     its exact numerator and denominator as 64-bit integers (an integer
+//     too large for 64 bits is stored as the sentinel -2^63 followed by
+//     the index of its decimal text);
+//   * the body, written by the game representation, in which all
+//     quantities are 32-bit words, and labels and numbers are indices
+//     into the string and value tables.
+//
+// Multi-byte quantities are written in the byte order of the machine
+// writing the file; the byte-order mark allows a reader to detect files
+// it cannot read.
+//
+
+/// The kinds of games which can be stored in binary savefiles
+typedef enum {
+  BINARY_GAME_TABLE = 1, BINARY_GAME_TREE = 2
+} BinaryGameKind;
+
+/// Returns true if the data begin with the signature of a binary savefile
+bool IsBinaryGameFile(const char *p_begin, const char *p_end);
+
+/// Reads the binary savefile held in the range [p_begin, p_end)
+Game ReadBinaryGame(const char *p_begin, const char *p_end);
+
+///
+/// Accumulates the body of a binary savefile, collecting the strings
+/// and numbers it references into tables.
+///
+class BinaryFileWriter {
+private:
+  BinaryGameKind m_kind;
+  std::string m_body;
+  std::vector<std::string> m_strings;
+  std::map<std::string, unsigned int> m_stringIndex;
+  std::vector<Number> m_values;
+  std::map<std::string, unsigned int> m_valueIndex;
+
+  unsigned int StringIndex(const std::string &);
+
+public:
+  BinaryFileWriter(BinaryGameKind p_kind) : m_kind(p_kind) { }
+
+  /// Appends a count, index, or other nonnegative integer to the body
+  void WriteCount(unsigned int);
+  /// Appends a reference to the string to the body
+  void WriteString(const std::string &);
+  /// Appends a reference to the number to the body
+  void WriteNumber(const Number &);
+
+  /// Writes the complete file to the stream
+  void Flush(std::ostream &) const;
+};
+
+///
+/// Decodes a binary savefile held in memory.  The header and tables
+/// are decoded on construction; the body is then read in the order
+/// in which it was written.
+///
+class BinaryFileReader {
+private:
+  const char *m_current, *m_end;
+  BinaryGameKind m_kind;
+  std::vector<std::string> m_strings;
+  std::vector<Number> m_values;
+
+  void Read(void *, size_t);
+  Integer ReadInteger(void);
+
+public:
+  BinaryFileReader(const char *p_begin, const char *p_end);
+
+  BinaryGameKind GetKind(void) const { return m_kind; }
+  /// Returns the number of bytes not yet read
+  size_t Remaining(void) const { return m_end - m_current; }
+
+  /// Reads a count, index, or other nonnegative integer from the body
+  unsigned int ReadCount(void);
+  /// Reads a count from the body, checking it does not exceed p_max
+  unsigned int ReadCount(unsigned int p_max);
+  /// Reads a reference to a string from the body
+  const std::string &ReadString(void);
+  /// Reads a reference to a number from the body
+  const Number &ReadNumber(void);
+};
+
+}  // end namespace Gambit
+
+#endif  // LIBGAMBIT_BINFILE_H
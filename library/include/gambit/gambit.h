@@ -125,6 +125,7 @@ public:
 #include "matrix.h"
 
 #include "rational.h"
+#include "random.h"
 
 
 #include "game.h"
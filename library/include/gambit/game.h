@@ -39,6 +39,10 @@ namespace Gambit {
 /// but will instead be marked as deleted.  Calling code should always
 /// be careful to check the deleted status of the object before any
 /// operations on it.
+///
+/// The reference count is not synchronized, so all the handles to the
+/// objects of any one game must be used by only one thread at a time.
+/// Distinct games share no objects, and may be used concurrently.
 class GameObject {
 protected:
   int m_refCount;
@@ -98,14 +102,18 @@ public:
   ~GameObjectPtr() { if (rep) rep->DecRef(); }
 
   GameObjectPtr<T> &operator=(const GameObjectPtr<T> &r)
-    { if (&r != this) {
+    { if (r.rep != rep) {
+	if (r.rep) r.rep->IncRef();
 	if (rep) rep->DecRef();
 	rep = r.rep;
-	if (rep) rep->IncRef();
       }
       return *this;
     }
 
+  /// Exchanges the objects referred to, without changing reference counts
+  void swap(GameObjectPtr<T> &r)
+    { T *tmp = rep;  rep = r.rep;  r.rep = tmp; }
+
   T *operator->(void) const 
     { if (!rep) throw NullException();
       if (!rep->IsValid()) throw InvalidObjectException(); 
@@ -123,6 +131,33 @@ public:
   bool operator!(void) const { return !rep; }
 };
 
+//
+// This is a borrowed, non-owning handle to a member object of a game.
+// It does not take part in reference counting, and dereferencing it
+// does not check the object is valid.  It is for use by library code
+// which walks a game that is not changed during the walk; it must not
+// be kept beyond the life of the owning handle it was taken from.
+//
+template <class T> class GameObjectRef {
+private:
+  T *rep;
+
+public:
+  GameObjectRef(T *r = 0) : rep(r) { }
+  GameObjectRef(const GameObjectPtr<T> &r) : rep(r) { }
+
+  T *operator->(void) const { return rep; }
+
+  bool operator==(const GameObjectRef<T> &r) const { return (rep == r.rep); }
+  bool operator==(T *r) const { return (rep == r); }
+  bool operator!=(const GameObjectRef<T> &r) const { return (rep != r.rep); }
+  bool operator!=(T *r) const { return (rep != r); }
+
+  operator T *(void) const { return rep; }
+
+  bool operator!(void) const { return !rep; }
+};
+
 //
 // Forward declarations of classes defined in this file.
 //
@@ -147,6 +182,7 @@ typedef Array<GamePlayerRep *> GamePlayers;
 class GameNodeRep;
 typedef GameObjectPtr<GameNodeRep> GameNode;
 class GameTreeNodeRep;
+class CompiledGameTree;
 
 class GameRep;
 typedef GameObjectPtr<GameRep> Game;
@@ -236,11 +272,7 @@ public:
   template <class T> const T &GetPayoff(int pl) const 
     { return (const T &) m_payoffs[pl]; }
   /// Sets the payoff to player 'pl'
-  void SetPayoff(int pl, const std::string &p_value)
-  {
-    m_payoffs[pl] = p_value;
-    //m_game->ClearComputedValues();
-  }
+  void SetPayoff(int pl, const std::string &p_value);
 
   /// Map the outcome to the corresponding outcome in the unrestricted game
   GameOutcome Unrestrict(void) const 
@@ -613,6 +645,8 @@ private:
   Game m_efg;
   Array<Array<GameAction> > m_profile;
 
+  template <class T> T GetPayoff(const CompiledGameTree &, int node, int pl) const;
+
 public:
   /// @name Lifecycle
   //@{
@@ -648,6 +682,7 @@ public:
 
 /// This is the class for representing an arbitrary finite game.
 class GameRep : public GameObject {
+  friend class GameOutcomeRep;
   friend class GameTreeInfosetRep;
   friend class GamePlayerRep;
   friend class GameTreeNodeRep;
@@ -672,6 +707,8 @@ protected:
   virtual void BuildComputedValues(void) { }
   /// Have computed values been built?
   virtual bool HasComputedValues(void) const { return false; }
+  /// Discard any cached copies of the payoffs
+  virtual void ClearPayoffCache(void) const { }
   //@}
 
 
@@ -713,6 +750,12 @@ public:
   virtual Rational GetMinPayoff(int pl = 0) const = 0;
   /// Returns the largest payoff in any outcome of the game
   virtual Rational GetMaxPayoff(int pl = 0) const = 0;
+  /// Returns, for each player, the number of the class of players to
+  /// which the player belongs.  Players in the same class have the same
+  /// number of strategies, and exchanging any two of them (together with
+  /// their strategies) leaves the game unchanged.  Classes are numbered
+  /// from 1 in order of their first member.
+  virtual Array<int> GetPlayerClasses(void) const;
 
   /// Returns true if the game is perfect recall.  If not, the specified
   /// a pair of violating information sets is returned in the parameters.  
@@ -816,6 +859,11 @@ Game NewTable(const Array<int> &p_dim, bool p_sparseOutcomes = false);
 // all classes to be defined.
 
 inline Game GameOutcomeRep::GetGame(void) const { return m_game; }
+inline void GameOutcomeRep::SetPayoff(int pl, const std::string &p_value)
+{
+  m_payoffs[pl] = p_value;
+  m_game->ClearPayoffCache();
+}
 
 inline GamePlayer GameStrategyRep::GetPlayer(void) const { return m_player; }
 
@@ -839,8 +887,10 @@ template<> inline std::string PureBehaviorProfile::GetPayoff(int pl) const
 //=======================================================================
 
 
-/// Reads a game in .efg or .nfg format from the input stream
+/// Reads a game in .efg, .nfg, or binary format from the input stream
 Game ReadGame(std::istream &) throw (InvalidFileException);
+/// Reads a game from the named file, mapping it into memory if possible
+Game ReadGameFile(const std::string &) throw (InvalidFileException);
 
 } // end namespace gambit
 
@@ -137,6 +137,7 @@ public:
   virtual bool IsPerfectRecall(GameInfoset &, GameInfoset &) const
   { return true; }
   virtual bool IsConstSum(void) const;
+  virtual Array<int> GetPlayerClasses(void) const;
   /// Returns the smallest payoff in any outcome of the game
   virtual Rational GetMinPayoff(int) const 
   { return aggPtr->getMinPayoff(); }
@@ -27,12 +27,23 @@
 
 namespace Gambit {
 
+class BinaryFileReader;
+class BinaryFileWriter;
+
 class GameExplicitRep : public GameRep {
   template <class T> friend class MixedStrategyProfile;
 protected:
   Array<GamePlayerRep *> m_players;
   Array<GameOutcomeRep *> m_outcomes;
 
+  /// @name Copying games
+  //@{
+  /// Copies the title, comment, player labels, and outcomes of the game
+  /// into p_copy, which must have the same number of players and no
+  /// outcomes
+  void CopyCommonData(GameExplicitRep *p_copy) const;
+  //@}
+
   /// @name Writing data files
   //@{
   /// Write the game in .efg format to the specified stream
@@ -41,6 +52,13 @@ protected:
   /// Write the game in .nfg format to the specified stream
   virtual void WriteNfgFile(std::ostream &) const
   { throw UndefinedException(); }
+  /// Write the game in binary format to the specified stream
+  virtual void WriteBinaryFile(std::ostream &) const
+  { throw UndefinedException(); }
+  /// Write the outcomes and their payoffs to a binary savefile
+  void WriteBinaryOutcomes(BinaryFileWriter &) const;
+  /// Read outcomes written by WriteBinaryOutcomes() into the game
+  void ReadBinaryOutcomes(BinaryFileReader &);
   //@}
 
 public:
@@ -23,6 +23,7 @@
 #ifndef GAMETABLE_H
 #define GAMETABLE_H
 
+#include <vector>
 #include "gameexpl.h"
 
 namespace Gambit {
@@ -30,6 +31,7 @@ namespace Gambit {
 class GameTableRep : public GameExplicitRep {
   friend class StrategySupportProfile;
   friend class GamePlayerRep;
+  friend class GameStrategyRep;
   friend class TablePureStrategyProfileRep;
   friend class PureStrategyProfileRep;
   template <class T> friend class MixedStrategyProfile;
@@ -38,10 +40,26 @@ private:
   Array<GameOutcomeRep *> m_results;
   Game m_unrestricted;
 
+  /// @name Dense payoff tables
+  //@{
+  /// Payoffs stored player-major, one block of NumStrategyContingencies()
+  /// entries per player; built on demand from the outcomes
+  mutable std::vector<double> m_doublePayoffs;
+  mutable std::vector<Rational> m_rationalPayoffs;
+  mutable bool m_doublePayoffsValid, m_rationalPayoffsValid;
+  //@}
+
   /// @name Private auxiliary functions
   //@{
   void IndexStrategies(void);
   void RebuildTable(void);
+  template <class T> void BuildPayoffTable(std::vector<T> &) const;
+  //@}
+
+  /// @name Managing the representation
+  //@{
+  virtual void ClearPayoffCache(void) const
+  { m_doublePayoffsValid = m_rationalPayoffsValid = false; }
   //@}
 
 public:
@@ -51,12 +69,15 @@ public:
   /// If p_sparseOutcomes = true, outcomes for all contingencies are left null
   GameTableRep(const Array<int> &p_dim, bool p_sparseOutcomes = false);
   virtual Game Copy(void) const;
+  /// Construct a table game from the body of a binary savefile
+  static Game ReadBinaryFile(BinaryFileReader &);
   //@}
 
   /// @name General data access
   //@{
   virtual bool IsTree(void) const { return false; }
   virtual bool IsConstSum(void) const;
+  virtual Array<int> GetPlayerClasses(void) const;
   virtual bool IsPerfectRecall(GameInfoset &, GameInfoset &) const
   { return true; }
   //@}
@@ -120,6 +141,22 @@ public:
   //@{
   /// Write the game to a file in .nfg outcome format
   virtual void WriteNfgFile(std::ostream &) const;
+  /// Write the game to a binary savefile
+  virtual void WriteBinaryFile(std::ostream &) const;
+  //@}
+
+  /// @name Dense payoff tables
+  //@{
+  /// \brief Returns the table of payoffs to player pl
+  ///
+  /// Returns a pointer to a contiguous array of the payoffs to player pl,
+  /// one entry per contingency.  The payoff for the contingency with
+  /// index i (as computed by summing strategy offsets) is at position i-1.
+  /// The table is built lazily, and the pointer is invalidated by any
+  /// change to the outcomes or payoffs of the game.  Building the table
+  /// is not synchronized; code which reads the game from several threads
+  /// should obtain the tables it needs before starting them.
+  template <class T> const T *GetPayoffTable(int pl) const;
   //@}
 
   virtual PureStrategyProfile NewPureStrategyProfile(void) const;
@@ -130,6 +167,9 @@ public:
 
 };
 
+template<> const double *GameTableRep::GetPayoffTable(int pl) const;
+template<> const Rational *GameTableRep::GetPayoffTable(int pl) const;
+
 }
 
 
@@ -23,6 +23,7 @@
 #ifndef GAMETREE_H
 #define GAMETREE_H
 
+#include <vector>
 #include "gameexpl.h"
 
 namespace Gambit {
@@ -196,6 +197,89 @@ public:
 };
 
 
+///
+/// A read-only, flattened copy of the structure of a game tree, for
+/// algorithms which traverse the tree many times.  Nodes are indexed
+/// from zero in depth-first order, so the node numbered n has index
+/// n-1, and the successors of a node follow it contiguously.
+/// Information sets are indexed from zero, those of the personal
+/// players in order of player and number, followed by those of chance.
+/// Actions are numbered from one within their information set.
+///
+class CompiledGameTree {
+  friend class GameTreeRep;
+
+private:
+  int m_numPlayers, m_chanceOffset;
+  std::vector<int> m_parent, m_priorAction, m_infoset, m_outcome;
+  std::vector<int> m_childStart, m_children, m_subtreeEnd;
+  std::vector<int> m_playerOffset, m_player, m_number;
+  std::vector<int> m_actionStart, m_memberStart, m_members;
+  std::vector<double> m_doubleProbs, m_doublePayoffs;
+  std::vector<Rational> m_rationalProbs, m_rationalPayoffs;
+
+public:
+  CompiledGameTree(void) : m_numPlayers(0), m_chanceOffset(0) { }
+
+  /// @name Nodes
+  //@{
+  int NumNodes(void) const { return m_parent.size(); }
+  /// Returns the parent of the node, or -1 for the root
+  int GetParent(int n) const { return m_parent[n]; }
+  /// Returns the number of the action leading to the node, or 0 for the root
+  int GetPriorAction(int n) const { return m_priorAction[n]; }
+  /// Returns the information set of the node, or -1 for a terminal node
+  int GetInfoset(int n) const { return m_infoset[n]; }
+  int NumChildren(int n) const { return m_childStart[n+1] - m_childStart[n]; }
+  int GetChild(int n, int i) const { return m_children[m_childStart[n] + i - 1]; }
+  /// Returns one past the index of the last successor of the node
+  int GetSubtreeEnd(int n) const { return m_subtreeEnd[n]; }
+  bool HasOutcome(int n) const { return m_outcome[n] >= 0; }
+  /// Returns the payoff to player pl of the outcome at the node
+  template <class T> const T &GetPayoff(int n, int pl) const;
+  //@}
+
+  /// @name Information sets
+  //@{
+  int NumPlayers(void) const { return m_numPlayers; }
+  int NumInfosets(void) const { return m_player.size(); }
+  /// Returns the total number of actions, including those of chance
+  int NumActions(void) const { return m_actionStart.back(); }
+  /// Returns the index of the iset'th information set of player pl,
+  /// where player 0 is chance
+  int GetIndex(int pl, int iset) const
+  { return ((pl) ? m_playerOffset[pl-1] : m_chanceOffset) + iset - 1; }
+  /// Returns the player at the information set, or 0 for chance
+  int GetPlayer(int s) const { return m_player[s]; }
+  int GetNumber(int s) const { return m_number[s]; }
+  int NumActions(int s) const { return m_actionStart[s+1] - m_actionStart[s]; }
+  /// Returns the position of the first action of the information set
+  /// in an array of all the actions of the game, in index order
+  int GetActionOffset(int s) const { return m_actionStart[s]; }
+  int NumMembers(int s) const { return m_memberStart[s+1] - m_memberStart[s]; }
+  int GetMember(int s, int i) const { return m_members[m_memberStart[s] + i - 1]; }
+  /// Returns the probability of a chance action (zero for personal players)
+  template <class T> const T &GetActionProb(int s, int act) const;
+  //@}
+};
+
+template<> inline const double &
+CompiledGameTree::GetPayoff(int n, int pl) const
+{ return m_doublePayoffs[m_outcome[n] * m_numPlayers + pl - 1]; }
+
+template<> inline const Rational &
+CompiledGameTree::GetPayoff(int n, int pl) const
+{ return m_rationalPayoffs[m_outcome[n] * m_numPlayers + pl - 1]; }
+
+template<> inline const double &
+CompiledGameTree::GetActionProb(int s, int act) const
+{ return m_doubleProbs[m_actionStart[s] + act - 1]; }
+
+template<> inline const Rational &
+CompiledGameTree::GetActionProb(int s, int act) const
+{ return m_rationalProbs[m_actionStart[s] + act - 1]; }
+
+
 class GameTreeRep : public GameExplicitRep {
   friend class GameTreeNodeRep;
   friend class GameTreeInfosetRep;
@@ -204,10 +288,13 @@ protected:
   mutable bool m_computedValues, m_doCanon;
   GameTreeNodeRep *m_root;
   GamePlayerRep *m_chance;
+  mutable CompiledGameTree m_compiled;
+  mutable bool m_compiledValid;
 
   /// @name Private auxiliary functions
   //@{
   void NumberNodes(GameTreeNodeRep *, int &);
+  void CompileTree(void) const;
   //@}
 
   /// @name Managing the representation
@@ -217,6 +304,7 @@ protected:
   virtual void ClearComputedValues(void) const;
   /// Have computed values been built?
   virtual bool HasComputedValues(void) const { return m_computedValues; }
+  virtual void ClearPayoffCache(void) const { m_compiledValid = false; }
   //@}
 
 public: 
@@ -225,6 +313,8 @@ public:
   GameTreeRep(void);
   virtual ~GameTreeRep();
   virtual Game Copy(void) const;
+  /// Construct a tree game from the body of a binary savefile
+  static Game ReadBinaryFile(BinaryFileReader &);
   //@}
 
   /// @name General data access
@@ -253,6 +343,12 @@ public:
   virtual GameNode GetRoot(void) const { return m_root; } 
   /// Returns the number of nodes in the game
   int NumNodes(void) const;
+  /// Returns the flattened representation of the tree, building it if
+  /// the game has changed since it was last built.  Building is not
+  /// synchronized; code which reads the game from several threads
+  /// should obtain it before starting them.
+  const CompiledGameTree &GetCompiledTree(void) const
+  { if (!m_compiledValid) CompileTree();  return m_compiled; }
   //@}
 
   virtual void DeleteOutcome(const GameOutcome &);
@@ -262,6 +358,7 @@ public:
   virtual void WriteEfgFile(std::ostream &) const;
   virtual void WriteEfgFile(std::ostream &, const GameNode &p_node) const;
   virtual void WriteNfgFile(std::ostream &) const;
+  virtual void WriteBinaryFile(std::ostream &) const;
   //@}
 
   /// @name Dimensions of the game
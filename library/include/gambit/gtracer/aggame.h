@@ -24,6 +24,8 @@
 #ifndef GAMBIT_GTRACER_AGGAME_H
 #define GAMBIT_GTRACER_AGGAME_H
 
+#include <algorithm>
+#include <functional>
 #include "cmatrix.h"
 #include "gnmgame.h"
 #include "gambit/agg/agg.h"
@@ -126,6 +128,15 @@ class aggame : public gnmgame {
 
     const std::vector<int>& getPlayerClass(int cls){return aggPtr->getPlayerClass(cls);}
     int getPlayerClassSize(int cls){return aggPtr->getPlayerClass(cls).size();}
+    //the k-symmetric strategies are over the sorted action sets, so a
+    //player whose actions are out of order is in no class of them
+    int getClassOfPlayer(int p){
+      const std::vector<int> &as = aggPtr->getActionSet(p);
+      if (std::adjacent_find(as.begin(), as.end(), std::greater<int>()) != as.end()) {
+        return -1;
+      }
+      return aggPtr->getClassOfPlayer(p);
+    }
     int getNumKSymActions(){return aggPtr->getNumKSymActions();}
     int getNumKSymActions(int p){return aggPtr->getNumKSymActions(p);}
     int firstKSymAction(int p){return aggPtr->firstKSymAction(p);}
@@ -141,7 +152,7 @@ class aggame : public gnmgame {
   private:
 
   //helper functions for computing jacobian
-    void computePartialP_PureNode(int player,int act,std::vector<int>& tasks);
+    void computePartialP_PureNode(int player,int act,std::vector<int>& tasks,cvector &s);
     void computePartialP_bisect(int player,int act, std::vector<int>::iterator f,std::vector<int>::iterator l,Gambit::agg::aggdistrib& temp);
     void computePartialP(int player1, int act1, std::vector<int>& tasks,std::vector<int>& nontasks);
     void computePayoff(cmatrix& dest,int player1,int act1,int player2,int act2,Gambit::agg::trie_map<Gambit::agg::AggNumber>& cache);
@@ -173,8 +173,13 @@ class gnmgame {
   inline int getNumActions(int p) { return actions[p]; }
   inline int getMaxActions() { return maxActions; }
 
+  // the degree of each payoff as a polynomial in the mixed strategy
+  // profile; each is multilinear in the strategies of the other players
+  virtual int getPayoffDegree(){return numPlayers-1;}
+
   virtual int getNumPlayerClasses(){return numPlayers;}
   virtual int getPlayerClassSize(int cls){return 1;}
+  virtual int getClassOfPlayer(int p){return p;}
   virtual int getNumKSymActions(){return numActions;}
   virtual int getNumKSymActions(int p){return actions[p];}
   virtual int firstKSymAction(int p){return strategyOffset[p];}
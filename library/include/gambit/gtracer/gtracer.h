@@ -29,6 +29,7 @@
 #include "nfgame.h"
 #include "gnmgame.h"
 #include "aggame.h"
+#include "symgame.h"
 
 namespace Gambit {
 namespace gametracer {
@@ -0,0 +1,81 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/include/gtracer/symgame.h
+// Restriction of a game for Gametracer to symmetric strategy profiles
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef GAMBIT_GTRACER_SYMGAME_H
+#define GAMBIT_GTRACER_SYMGAME_H
+
+#include <vector>
+#include "gnmgame.h"
+#include "cmatrix.h"
+
+namespace Gambit {
+namespace gametracer {
+
+// The game on strategy profiles in which all the players in each class
+// of interchangeable players of another game play the same strategy.
+// Its players are the classes, and the payoff to a class is that to its
+// first member.  The payoffs are polynomials of the same degree as those
+// of the original game, so GNM traces in this game as in any other, but
+// in the dimension of one strategy per class.
+//
+// If the classes are those of the k-symmetric representation of the
+// original game, as for an action-graph game, the payoffs are computed
+// by that representation; otherwise from the full strategy profile.
+// The original game must outlive this one.
+class symgame : public gnmgame {
+ public:
+  // classes[i] is the class of player i of the game base, numbered from 0
+  // in order of the classes' first members
+  symgame(gnmgame &base, const std::vector<int> &classes);
+  ~symgame() { }
+
+  int getPayoffDegree() { return base.getPayoffDegree(); }
+
+  double getPurePayoff(int cls, int *s);
+  inline void setPurePayoff(int cls, int *s, double value) {
+    throw Gambit::UndefinedException();
+  }
+
+  double getMixedPayoff(int cls, cvector &s);
+  void payoffMatrix(cmatrix &dest, cvector &s, double fuzz);
+  void getPayoffVector(cvector &dest, int cls, const cvector &s);
+
+  // the strategy profile of the original game in which each player plays
+  // the strategy s gives its class
+  void expand(cvector &dest, const cvector &s);
+  // the sums over the members of each class of the entries of a vector
+  // over the actions of the original game
+  void fold(cvector &dest, const cvector &v);
+
+ private:
+  gnmgame &base;
+  std::vector<int> playerClass, representative;
+  bool native;
+
+  static std::vector<int> classActions(gnmgame &base,
+				       const std::vector<int> &classes);
+};
+
+}  // end namespace Gambit::gametracer
+}  // end namespace Gambit
+
+#endif  // GAMBIT_GTRACER_SYMGAME_H
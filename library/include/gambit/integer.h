@@ -82,9 +82,32 @@ extern int      Iislong(const IntegerRep*);
 extern int      Iisdouble(const IntegerRep*);
 extern long     lg(const IntegerRep*);
 
+class IntegerRepRef;
+
+//
+// Values which fit in a machine word are held directly in the object,
+// and arithmetic on them is done with machine instructions, checking
+// for overflow.  Only values which do not fit are held in a heap-allocated
+// IntegerRep and use the multiple-precision routines.
+//
 class Integer {
+  friend class IntegerRepRef;
+
 protected:
+  /// The multiple-precision representation, or null if the value is
+  /// held in m_small
   IntegerRep *rep;
+  /// The value, if rep is null.  This is never LONG_MIN, so that
+  /// negation and absolute value of small values cannot overflow.
+  long m_small;
+
+  /// Sets the value to a small value, releasing any representation
+  void SetSmall(long);
+  /// Makes rep hold the value, allocating it if necessary
+  IntegerRep *Promote(void);
+  /// Takes the result of a multiple-precision routine as the value,
+  /// holding it as a small value if it fits
+  void Assign(IntegerRep *);
 
 public:
   /// @name Lifecycle
@@ -218,11 +241,11 @@ public:
 
   // coercion & conversion
 
-  int             fits_in_long() const { return Iislong(rep); }
-  int             fits_in_double() const { return Iisdouble(rep); }
+  int             fits_in_long() const { return !rep || Iislong(rep); }
+  int             fits_in_double() const { return !rep || Iisdouble(rep); }
 
-  long		  as_long() const { return Itolong(rep); }
-  double	  as_double() const { return Itodouble(rep); }
+  long		  as_long() const { return (rep) ? Itolong(rep) : m_small; }
+  double	  as_double() const { return (rep) ? Itodouble(rep) : (double) m_small; }
 
   friend std::string Itoa(const Integer &x, int base /*= 10*/, int width /*= 0*/);
   friend Integer atoI(const char *s, int base/*= 10*/);
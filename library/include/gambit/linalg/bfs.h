@@ -24,29 +24,72 @@
 #define BFS_H
 
 #include "gambit/gambit.h"
-#include <map>
+#include <vector>
+#include <algorithm>
 
 namespace Gambit  {
 
 namespace linalg  {
-  
+
+//
+// A basic feasible solution, as the set of basic variables, identified
+// by their labels, with their values.  The basis is a bitset over a
+// range of labels, which grows as labels outside it are inserted; the
+// tableaux construct their solutions over the full range of labels.
+// The values are kept densely, by the position of their variables in
+// the order of insertion.  Membership is a bit test, and the hash of
+// the basis is kept up to date as labels are inserted.
+//
 template <class T> class BFS {
 private:
-  std::map<int, T> m_map;
+  int m_first;                         // label of the first bit
+  std::vector<unsigned long> m_basis;  // bitset of the basic labels
+  std::vector<int> m_position;         // position of each basic label
+  std::vector<int> m_labels;           // basic labels, by position
+  std::vector<T> m_values;             // values, by position
+  unsigned int m_hash;
   T m_default;
 
+  static const int WORD_BITS = 8 * sizeof(unsigned long);
+
+  bool IsBasic(int p_index) const
+  { return (m_basis[p_index / WORD_BITS] >> (p_index % WORD_BITS)) & 1ul; }
+  void SetBasic(int p_index)
+  { m_basis[p_index / WORD_BITS] |= 1ul << (p_index % WORD_BITS); }
+  int Index(int p_key) const
+  {
+    int index = p_key - m_first;
+    return (index >= 0 && index < (int) m_position.size()) ? index : -1;
+  }
+  // Widens the range of labels to include those from p_first to p_last
+  void Extend(int p_first, int p_last);
+  // The contribution of a label to the hash of a basis
+  static unsigned int Mix(int p_key)
+  {
+    unsigned int h = (unsigned int) p_key * 2654435761u;
+    h ^= h >> 15;
+    h *= 0x2c1b3c6du;
+    return h ^ (h >> 12);
+  }
+
 public:
   // Lifecycle
-  BFS(void) : m_default(0) { }
+  BFS(void) : m_first(0), m_hash(0), m_default(0) { }
+  /// Constructs an empty solution over the labels p_first to p_last
+  BFS(int p_first, int p_last) : m_first(0), m_hash(0), m_default(0)
+  { Extend(p_first, p_last); }
   ~BFS()  { }
 
   // define two BFS's to be equal if their bases are equal
   bool operator==(const BFS &M) const {
-    if (m_map.size() != M.m_map.size())  return false;
-
-    for (typename std::map<int, T>::const_iterator iter = m_map.begin();
-	 iter != m_map.end(); iter++) {
-      if (M.m_map.count((*iter).first) == 0) {
+    if (m_labels.size() != M.m_labels.size() || m_hash != M.m_hash) {
+      return false;
+    }
+    if (m_first == M.m_first && m_position.size() == M.m_position.size()) {
+      return (m_basis == M.m_basis);
+    }
+    for (size_t i = 0; i < m_labels.size(); i++) {
+      if (!M.count(m_labels[i])) {
 	return false;
       }
     }
@@ -54,17 +97,34 @@ public:
   }
   bool operator!=(const BFS &M) const  { return !(*this == M); }
 
+  /// A hash of the basis, for which equal solutions hash equally
+  unsigned int Hash(void) const { return m_hash; }
+
   // Provide map-like operations
-  int count(int key) const { return (m_map.count(key) > 0); }
+  int count(int key) const
+  { int index = Index(key); return (index >= 0 && IsBasic(index)); }
 
   void insert(int key, const T &value) {
-    m_map.erase(key);
-    m_map.insert(std::pair<int, T>(key, value));
+    if (Index(key) < 0) {
+      Extend(key, key);
+    }
+    int index = key - m_first;
+    if (IsBasic(index)) {
+      m_values[m_position[index]] = value;
+    }
+    else {
+      SetBasic(index);
+      m_position[index] = m_labels.size();
+      m_labels.push_back(key);
+      m_values.push_back(value);
+      m_hash += Mix(key);
+    }
   }
 
   const T &operator[](int key) const {
-    if (m_map.count(key) == 1) {
-      return const_cast<std::map<int, T> &>(m_map)[key];
+    int index = Index(key);
+    if (index >= 0 && IsBasic(index)) {
+      return m_values[m_position[index]];
     }
     else {
       return m_default;
@@ -72,11 +132,23 @@ public:
   }
 };
 
+template <class T> void BFS<T>::Extend(int p_first, int p_last)
+{
+  if (!m_position.empty()) {
+    p_first = std::min(p_first, m_first);
+    p_last = std::max(p_last, m_first + (int) m_position.size() - 1);
+  }
+  m_first = p_first;
+  m_position.assign(p_last - p_first + 1, -1);
+  m_basis.assign(m_position.size() / WORD_BITS + 1, 0ul);
+  for (size_t i = 0; i < m_labels.size(); i++) {
+    SetBasic(m_labels[i] - m_first);
+    m_position[m_labels[i] - m_first] = i;
+  }
+}
+
 }  // end namespace Gambit::linalg
 
 }  // end namespace Gambit
  
 #endif   // BFS_H
-
-
-
@@ -64,6 +64,8 @@ private:
 
   Vector<T> scratch1; // scratch vectors so we don't reallocate them
   Vector<T> scratch2; // everytime we do something.
+  // The const members use neither of these, so that copies made in
+  // different threads can solve using their common parent at once.
 
   int refactor_number;
   int iterations;
@@ -72,6 +74,10 @@ private:
   const LUdecomp<T> *parent;
   int copycount;
 
+  // Changes the count of copies of p_parent; copies of one
+  // decomposition may be made and released in different threads.
+  static void CountCopy(const LUdecomp<T> *p_parent, int p_change);
+
   // don't use this copy constructor
   LUdecomp( const LUdecomp<T> &a);
   // don't use the equals operator, use the Copy function instead
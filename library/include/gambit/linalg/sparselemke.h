@@ -0,0 +1,141 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/include/gambit/linalg/sparselemke.h
+// Lemke tableau over a sparse constraint matrix
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef GAMBIT_LINALG_SPARSELEMKE_H
+#define GAMBIT_LINALG_SPARSELEMKE_H
+
+#include <map>
+#include <vector>
+#include "gambit/linalg/btableau.h"
+
+namespace Gambit {
+namespace linalg {
+
+//
+// A tableau for Lemke's algorithm which, unlike LemkeTableau, never
+// forms a dense matrix, and so can be used for the sequence form of
+// large extensive games.
+//
+// The constraint matrix is held in compressed sparse column form.  As in
+// Tableau, column j of the matrix is the variable labeled j (column 0
+// being the artificial variable), and the slack variable for row i is
+// labeled -i.  The inverse of the basis is held in product form, as a
+// sequence of sparse eta columns, one for each pivot; the etas are
+// rebuilt from the basic columns after every REFACTOR_INTERVAL pivots
+// to limit their number and the accumulation of rounding errors.
+//
+// Degeneracy is resolved by the same lexicographic rule as
+// LemkeTableau::SF_ExitIndex.
+//
+template <class T> class SparseLemkeTableau {
+public:
+  class BadPivot : public Exception  {
+  public:
+    virtual ~BadPivot() throw() { }
+    const char *what(void) const throw() { return "Bad pivot in SparseLemkeTableau"; }
+  };
+  class BadExitIndex : public Exception  {
+  public:
+    virtual ~BadExitIndex() throw() { }
+    const char *what(void) const throw() { return "Bad exit index in SparseLemkeTableau"; }
+  };
+
+  /// Number of pivots between refactorizations of the basis
+  static const int REFACTOR_INTERVAL = 100;
+
+  /// @name Lifecycle
+  //@{
+  /// Constructs the tableau with all slack variables basic.  The
+  /// columns are indexed from zero, and each maps row numbers to entries.
+  SparseLemkeTableau(const std::vector<std::map<int, T> > &p_columns,
+		     const Vector<T> &p_b);
+  //@}
+
+  /// @name General information
+  //@{
+  int MinRow(void) const  { return 1; }
+  int MaxRow(void) const  { return m_numRows; }
+  int MinCol(void) const  { return 0; }
+  int MaxCol(void) const  { return m_numRows; }
+  T Epsilon(void) const  { return m_eps2; }
+  long NumPivots(void) const  { return m_numPivots; }
+
+  /// Is the variable basic?
+  bool Member(int label) const  { return m_position[label + m_numRows] != 0; }
+  /// Returns the label of the variable basic in the row
+  int Label(int row) const  { return m_label[row]; }
+  /// Returns the row in which the variable is basic
+  int Find(int label) const  { return m_position[label + m_numRows]; }
+  /// Returns the values of the basic variables, by row
+  void BasisVector(Vector<T> &p_values) const  { p_values = m_values; }
+  //@}
+
+  /// @name Pivoting operations
+  //@{
+  /// Brings the variable into the basis in place of the one basic in the row
+  void Pivot(int outrow, int inlabel);
+  /// Rebuilds the eta columns from the current basis
+  void Refactor(void);
+
+  int SF_PivotIn(int inlabel);
+  int SF_ExitIndex(int inlabel);
+  /// Follows a path of almost-complementary bases to a complementary one
+  int SF_LCPPath(int dup);
+  //@}
+
+private:
+  int m_numRows;
+  // Column j holds the entries m_colStart[j] to m_colStart[j+1]-1
+  std::vector<int> m_colStart, m_rowIndex;
+  std::vector<T> m_entries;
+  Vector<T> m_b;
+  T m_eps1, m_eps2;
+
+  // Labels of the basic variables by row, and the row of each
+  // variable (offset by the number of rows), or zero if it is not basic
+  std::vector<int> m_label, m_position;
+  Vector<T> m_values;
+
+  // Eta k pivots on row m_etaRow[k], with pivot entry m_etaPivot[k]
+  // and the other entries m_etaStart[k] to m_etaStart[k+1]-1
+  std::vector<int> m_etaRow, m_etaStart, m_etaIndex;
+  std::vector<T> m_etaPivot, m_etaEntries;
+  int m_pivotsSinceRefactor;
+  long m_numPivots;
+
+  // The column of the basis inverse times the column of m_solvedLabel,
+  // computed when choosing the row to leave and reused by Pivot
+  int m_solvedLabel;
+  Vector<T> m_solved;
+
+  /// Multiplies the vector by the basis inverse
+  void Solve(Vector<T> &) const;
+  /// Computes the basis inverse times the column of the variable
+  void SolveColumn(int label, Vector<T> &) const;
+  /// Appends the eta column for pivoting the solved column on the row
+  void AddEta(int row, const Vector<T> &);
+};
+
+}  // end namespace Gambit::linalg
+}  // end namespace Gambit
+
+#endif  // GAMBIT_LINALG_SPARSELEMKE_H
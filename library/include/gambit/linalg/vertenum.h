@@ -23,6 +23,9 @@
 #ifndef GAMBIT_LINALG_VERTENUM_H
 #define GAMBIT_LINALG_VERTENUM_H
 
+#include <vector>
+#include <deque>
+#include <string>
 #include "gambit/gambit.h"
 #include "gambit/linalg/lptab.h"
 #include "gambit/linalg/bfs.h"
@@ -30,21 +33,37 @@
 namespace Gambit {
 namespace linalg {
 
+template <class T> class VertexSearchPool;
+
 //
 // This class enumerates the vertices of the convex polyhedron 
 //
 //        P = { y : Ay + b <= 0, y>=0 }
 // 
 // where b <= 0.  Enumeration starts from the vertex y = 0.
-// All computation is done in the class constructor. The 
-// list of vertices can be accessed by VertexList()
+// All computation is done in the class constructor, unless a
+// VertexSearchPool is given, in which case the search is carried out
+// when the pool is run.  The list of vertices can be accessed by
+// VertexList(); it is in the same order however many threads search.
 //  
 // The code is based on the reverse Pivoting algorithm of Avis 
 // and Fukuda, Discrete Computational Geom (1992) 8:295-313.
 //
 template <class T> class VertexEnumerator {
+  friend class VertexSearchPool<T>;
+
 private:
-  int mult_opt,depth;
+  // A vertex found by the search, with the sequence of branches taken
+  // to reach it, by which the vertices are put in order
+  struct Record {
+    std::vector<int> m_path;
+    BFS<T> m_bfs, m_dual;
+
+    bool operator<(const Record &p_other) const
+    { return m_path < p_other.m_path; }
+  };
+
+  int mult_opt;
   int n;  // N is the number of columns, which is the # of dimensions.
   int k;  // K is the number of inequalities given.
   const Matrix<T> &A;   
@@ -53,18 +72,20 @@ private:
   Gambit::List<BFS<T> > List;
   Gambit::List<BFS<T> > DualList;
   Gambit::List<Vector<T> > Verts;
-  long npivots, nodes;
-  Gambit::List<long> visits,branches;
+  long npivots;
+  int m_roots;
+  std::vector<Record> m_records;
 
-  void Enum(void);
-  void Deeper(void);
-  void Report(void);
-  void Search(LPTableau<T> &tab);
-  void DualSearch(LPTableau<T> &tab);
+  void Enum(VertexSearchPool<T> &);
+  void Search(LPTableau<T> &tab, std::vector<int> &p_path,
+	      long &p_budget, long &p_pivots, VertexSearchPool<T> &);
+  void DualSearch(LPTableau<T> &tab, VertexSearchPool<T> &);
+  void Finish(void);
 
 public:
-  VertexEnumerator(const Matrix<T> &, const Vector<T> &);
-  VertexEnumerator(LPTableau<T> &);
+  VertexEnumerator(const Matrix<T> &, const Vector<T> &,
+		   VertexSearchPool<T> *p_pool = 0);
+  VertexEnumerator(LPTableau<T> &, VertexSearchPool<T> *p_pool = 0);
   ~VertexEnumerator() { }
   
   const Gambit::List<BFS<T> > &VertexList(void) const
@@ -75,6 +96,46 @@ public:
   long NumPivots(void) const { return npivots; }
 };
 
+//
+// A pool of threads carrying out the reverse searches of any number
+// of VertexEnumerators.  The subtrees yet to be searched are tasks
+// in a common queue.  A thread searches the subtree of a task
+// depth-first until it has visited a budget of nodes, then queues
+// the subtrees it has not reached as new tasks for the other threads.
+// The budget does not depend on the timing of the threads, so that
+// neither does the division of the trees into tasks; with a single
+// thread the trees are searched whole.
+//
+template <class T> class VertexSearchPool {
+  friend class VertexEnumerator<T>;
+
+public:
+  VertexSearchPool(long p_budget = 200)
+    : m_budget(p_budget), m_active(0) { }
+  ~VertexSearchPool();
+
+  /// Carries out the searches of the enumerators constructed on
+  /// the pool since it was last run
+  void Run(void);
+
+private:
+  struct Task {
+    VertexEnumerator<T> *m_owner;
+    LPTableau<T> *m_tab;
+    std::vector<int> m_path;
+  };
+
+  long m_budget;
+  int m_active;
+  std::deque<Task> m_tasks;
+  std::vector<VertexEnumerator<T> *> m_enumerators;
+  std::string m_error;
+
+  /// Queues the subtree rooted at a copy of the tableau
+  void Push(VertexEnumerator<T> *p_owner, const LPTableau<T> &p_tab,
+	    const std::vector<int> &p_path);
+};
+
 }  // end namespace Gambit::linalg
 }  // end namespace Gambit
  
@@ -24,6 +24,7 @@
 #define LIBGAMBIT_MIXED_H
 
 #include "vector.h"
+#include "matrix.h"
 #include "gameagg.h"
 #include "gamebagg.h"
 
@@ -41,7 +42,9 @@ public:
   void SetCentroid(void);
   void Normalize(void);
   void Randomize(void);
+  void Randomize(RandomGenerator &);
   void Randomize(int p_denom);
+  void Randomize(int p_denom, RandomGenerator &);
  /// Returns the probability the strategy is played
   const T &operator[](const GameStrategy &p_strategy) const
     { return m_probs[m_support.m_profileIndex[p_strategy->GetId()]]; }
@@ -52,6 +55,11 @@ public:
   virtual T GetPayoff(int pl) const = 0;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const = 0;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const = 0;
+  /// Computes the payoff to each strategy of player pl in the support
+  virtual Vector<T> GetStrategyValues(int pl) const;
+  /// Computes the second derivatives of the payoff to player pl with
+  /// respect to each of his strategies and each other player's strategies
+  virtual Matrix<T> GetPayoffDerivs(int pl) const;
 };
 
 template <class T> class TreeMixedStrategyProfileRep 
@@ -72,16 +80,17 @@ public:
 template <class T> class TableMixedStrategyProfileRep
   : public MixedStrategyProfileRep<T> {
 private:
-  /// @name Private recursive payoff functions
+  /// @name Private payoff contraction functions
   //@{
-  /// Recursive computation of payoff to player pl
-  T GetPayoff(int pl, int index, int i) const;
-  /// Recursive computation of payoff derivative
-  void GetPayoffDeriv(int pl, int const_pl, int cur_pl, long index,
-		      const T &prob, T &value) const;
-  /// Recursive computation of payoff second derivative
-  void GetPayoffDeriv(int pl, int const_pl1, int const_pl2, 
-		      int cur_pl, long index, const T &prob, T &value) const;
+  /// Fills in the weight of each strategy of each player in the profile,
+  /// indexed by strategy number.  Strategies outside the support (and,
+  /// if p_positiveOnly, with nonpositive probability) have zero weight.
+  void GetWeights(Array<std::vector<T> > &p_weights, bool p_positiveOnly) const;
+  /// Contracts the payoff table of player pl against the weights,
+  /// summing out every player not flagged in p_keep.  The result is
+  /// the table over the kept players' strategies.
+  void Contract(int pl, const Array<std::vector<T> > &p_weights,
+		const Array<bool> &p_keep, std::vector<T> &p_result) const;
   //@}
 
 public:
@@ -94,6 +103,8 @@ public:
   virtual T GetPayoff(int pl) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const;
+  virtual Vector<T> GetStrategyValues(int pl) const;
+  virtual Matrix<T> GetPayoffDerivs(int pl) const;
 };
 
 template <class T> class AggMixedStrategyProfileRep
@@ -111,6 +122,7 @@ public:
   virtual T GetPayoff(int pl) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &) const;
   virtual T GetPayoffDeriv(int pl, const GameStrategy &, const GameStrategy &) const;
+  virtual Vector<T> GetStrategyValues(int pl) const;
 };
 
 template <class T> class BagentMixedStrategyProfileRep
@@ -211,10 +223,17 @@ public:
 
   /// Generate a random mixed strategy profile according to the uniform distribution
   void Randomize(void) { m_rep->Randomize(); }
+  /// Generate a random mixed strategy profile according to the uniform distribution,
+  /// drawing from the specified generator
+  void Randomize(RandomGenerator &p_generator) { m_rep->Randomize(p_generator); }
 
   /// Generate a random mixed strategy profile according to the uniform distribution
   /// on a grid with spacing p_denom
   void Randomize(int p_denom) { m_rep->Randomize(p_denom); }
+  /// Generate a random mixed strategy profile according to the uniform distribution
+  /// on a grid with spacing p_denom, drawing from the specified generator
+  void Randomize(int p_denom, RandomGenerator &p_generator)
+  { m_rep->Randomize(p_denom, p_generator); }
 
   /// Returns the total number of strategies in the profile
   int MixedProfileLength(void) const { return m_rep->m_probs.Length(); }
@@ -253,6 +272,26 @@ public:
   T GetPayoff(const GameStrategy &p_strategy) const
   { return GetPayoffDeriv(p_strategy->GetPlayer()->GetNumber(), p_strategy); }
 
+  /// \brief Computes the payoffs to all the player's strategies
+  ///
+  /// Computes the payoff to playing each of the player's strategies in
+  /// the support against the profile, in the order of the support.
+  /// This is equivalent to calling GetPayoff() for each strategy, but
+  /// representations may compute all the values in one pass.
+  Vector<T> GetStrategyValues(const GamePlayer &p_player) const;
+
+  /// \brief Computes all second derivatives of the player's payoff
+  ///
+  /// Computes the second derivative of the payoff to the player with
+  /// respect to the probabilities of each pair of strategies, where the
+  /// first is one of the player's strategies and the second is any
+  /// other player's strategy.  Rows are indexed by the player's strategies
+  /// in the order of the support, and columns by position in the profile;
+  /// columns for the player's own strategies are zero.  Each entry is
+  /// equal to the corresponding GetPayoffDeriv(), but representations
+  /// may compute all the entries in one pass.
+  Matrix<T> GetPayoffDerivs(const GamePlayer &p_player) const;
+
   /// \brief Computes the Lyapunov value of the profile
   ///
   /// Computes the Lyapunov value of the profile.  This is a nonnegative
@@ -23,6 +23,7 @@
 #ifndef LIBGAMBIT_NASH_H
 #define LIBGAMBIT_NASH_H
 
+#include <vector>
 #include "gambit/gambit.h"
 
 namespace Gambit {
@@ -142,6 +143,78 @@ private:
   int m_numDecimals;
 };
 
+//------------------------------------------------------------------------
+//                    Reporting from independent runs
+//------------------------------------------------------------------------
+
+//
+// Collects the profiles found by independent runs of a method, such as
+// runs from different starting points or perturbations, which may be
+// carried out concurrently.  Game objects may not be shared between
+// threads, so each thread works on its own copy of the game, and the
+// profiles rendered during a run are recorded as vectors of
+// probabilities.  The records of each run are rendered on the original
+// game in the order of the runs, as soon as all earlier runs are
+// finished.  The output is therefore the same as that of making the
+// runs one after another, except that an equilibrium (a profile with
+// the label "NE") within the tolerance of one already rendered, in
+// every probability, is not rendered again; a tolerance of zero renders
+// every equilibrium.
+//
+template <class T> class ProfileSweep {
+public:
+  ProfileSweep(const Game &p_game, int p_numRuns, double p_tolerance,
+	       const StrategyProfileRenderer<T> &p_renderer);
+
+  /// Returns the number of threads available to carry out runs
+  static int NumThreads(void);
+  /// Returns the copy of the game belonging to the calling thread
+  const Game &GetThreadGame(void) const;
+
+  /// Returns a renderer recording the profiles of run p_run (from 1)
+  shared_ptr<StrategyProfileRenderer<T> > GetRecorder(int p_run);
+  /// Marks run p_run as finished, rendering all records now in order
+  void Finish(int p_run);
+  /// Records an error during a run; the first recorded is kept
+  void Fail(const std::string &p_message);
+  /// Throws the first error recorded, if any
+  void CheckErrors(void) const;
+
+  /// Returns the distinct equilibria rendered so far
+  const List<MixedStrategyProfile<T> > &GetEquilibria(void) const
+  { return m_strategyEquilibria; }
+  const List<MixedBehaviorProfile<T> > &GetBehavEquilibria(void) const
+  { return m_behavEquilibria; }
+
+private:
+  class Record {
+  public:
+    std::string m_label;
+    bool m_isBehav;
+    Vector<T> m_probs;
+
+    Record(const std::string &p_label, bool p_isBehav,
+	   const Vector<T> &p_probs)
+      : m_label(p_label), m_isBehav(p_isBehav), m_probs(p_probs) { }
+  };
+  class Recorder;
+
+  Game m_game;
+  std::vector<Game> m_threadGames;
+  double m_tolerance;
+  const StrategyProfileRenderer<T> &m_renderer;
+  std::vector<std::vector<Record> > m_records;
+  std::vector<bool> m_done;
+  int m_next;
+  List<Vector<T> > m_found;
+  List<MixedStrategyProfile<T> > m_strategyEquilibria;
+  List<MixedBehaviorProfile<T> > m_behavEquilibria;
+  std::string m_error;
+
+  bool IsDuplicate(const Vector<T> &) const;
+  void Replay(const Record &);
+};
+
 //------------------------------------------------------------------------
 //                      Algorithm base classes
 //------------------------------------------------------------------------
@@ -77,6 +77,8 @@ public:
 private:
   /// Implement fuzzy equality for floating-point version when testing Nashness
   static bool EqZero(const T &x);
+  /// Whether the product of x with a value at least as large is nonzero
+  static bool IsLabel(const T &x) { return !EqZero(x * x); }
 };
 
  
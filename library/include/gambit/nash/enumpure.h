@@ -39,24 +39,11 @@ public:
   virtual ~EnumPureStrategySolver()  { }
 
   List<MixedStrategyProfile<Rational> > Solve(const Game &p_game) const;
-};
 
-inline List<MixedStrategyProfile<Rational> >
-EnumPureStrategySolver::Solve(const Game &p_game) const
-{
-  if (!p_game->IsPerfectRecall()) {
-    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
-  }
-  List<MixedStrategyProfile<Rational> > solutions;
-  for (StrategyProfileIterator citer(p_game); !citer.AtEnd(); citer++) {
-    if ((*citer)->IsNash()) {
-      MixedStrategyProfile<Rational> profile = (*citer)->ToMixedStrategyProfile();
-      m_onEquilibrium->Render(profile);
-      solutions.Append(profile);
-    }
-  }
-  return solutions;
-}
+private:
+  /// Enumerate the equilibria of a game table by marking best responses
+  List<MixedStrategyProfile<Rational> > SolveTable(const Game &p_game) const;
+};
 
 ///
 /// Enumerate pure-strategy agent Nash equilibria of a game.  This uses
@@ -31,23 +31,37 @@ namespace Nash {
 
 class NashGNMStrategySolver : public StrategySolver<double> {
 public:
+  /// If p_symmetric is set, the search is restricted to profiles in which
+  /// interchangeable players (see GameRep::GetPlayerClasses) play alike
   NashGNMStrategySolver(shared_ptr<StrategyProfileRenderer<double> > p_onEquilibrium = 0,
-			bool p_verbose=false)
+			bool p_verbose=false, double p_tolerance = 1.0e-4,
+			bool p_symmetric = false)
     : StrategySolver<double>(p_onEquilibrium),
-      m_verbose(p_verbose)
+      m_verbose(p_verbose), m_symmetric(p_symmetric),
+      m_tolerance(p_tolerance)
   { }
   virtual ~NashGNMStrategySolver() { }
 
   List<MixedStrategyProfile<double> > Solve(const Game &p_game) const;
   List<MixedStrategyProfile<double> > Solve(const Game &p_game,
 					    const MixedStrategyProfile<double> &p_pert) const;
+  /// Traces from each of the perturbations, concurrently where possible,
+  /// reporting each equilibrium found only once (see ProfileSweep)
+  List<MixedStrategyProfile<double> > Solve(const Game &p_game,
+					    const List<MixedStrategyProfile<double> > &p_perts) const;
 
 private:
-  bool m_verbose;
+  bool m_verbose, m_symmetric;
+  double m_tolerance;
   
+  /// Traces from the perturbation in the game A.  If p_classes is not
+  /// empty, only profiles in which the players in each class (numbered
+  /// from zero, one entry per player) play the same strategy are considered.
   List<MixedStrategyProfile<double> > Solve(const Game &p_game,
-					    shared_ptr<gametracer::gnmgame> A,
-					    const gametracer::cvector &p_pert) const;
+					    gametracer::gnmgame &A,
+					    const gametracer::cvector &p_pert,
+					    const std::vector<int> &p_classes) const;
+  std::vector<int> GetPlayerClasses(const Game &p_game) const;
   shared_ptr<gametracer::gnmgame> BuildRepresentation(const Game &p_game) const;
 
   static MixedStrategyProfile<double> ToProfile(const Game &p_game,
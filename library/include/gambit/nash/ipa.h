@@ -24,20 +24,34 @@
 #define GAMBIT_NASH_IPA_H
 
 #include "gambit/nash.h"
+#include "gambit/gtracer/gtracer.h"
 
 namespace Gambit {
 namespace Nash {
 
 class NashIPAStrategySolver : public StrategySolver<double> {
 public:
-  NashIPAStrategySolver(shared_ptr<StrategyProfileRenderer<double> > p_onEquilibrium = 0)
-    : StrategySolver<double>(p_onEquilibrium)
+  NashIPAStrategySolver(shared_ptr<StrategyProfileRenderer<double> > p_onEquilibrium = 0,
+			double p_tolerance = 1.0e-4)
+    : StrategySolver<double>(p_onEquilibrium), m_tolerance(p_tolerance)
   { }
   virtual ~NashIPAStrategySolver() { }
 
   List<MixedStrategyProfile<double> > Solve(const Game &p_game) const;
   List<MixedStrategyProfile<double> > Solve(const Game &p_game,
 					    const Array<double> &p_pert) const;
+  /// Traces from each of the perturbations, concurrently where possible,
+  /// reporting each equilibrium found only once (see ProfileSweep)
+  List<MixedStrategyProfile<double> > Solve(const Game &p_game,
+					    const List<MixedStrategyProfile<double> > &p_perts) const;
+
+private:
+  double m_tolerance;
+
+  List<MixedStrategyProfile<double> > Solve(const Game &p_game,
+					    gametracer::gnmgame &A,
+					    const Array<double> &p_pert) const;
+  shared_ptr<gametracer::gnmgame> BuildRepresentation(const Game &p_game) const;
 };
 
 }  // end namespace Gambit::Nash
@@ -56,27 +56,35 @@ private:
  
 template <class T> class NashLcpBehaviorSolver : public BehavSolver<T> {
 public:
+  /// If p_sparse is true, the sequence form is solved without forming
+  /// it as a dense matrix, following only the path from the primary ray
+  /// to a single equilibrium
   NashLcpBehaviorSolver(int p_stopAfter, int p_maxDepth,
-			Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0)
+			Gambit::shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium = 0,
+			bool p_sparse = false)
     : BehavSolver<T>(p_onEquilibrium),
-      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth) { }
+      m_stopAfter(p_stopAfter), m_maxDepth(p_maxDepth), m_sparse(p_sparse) { }
   virtual ~NashLcpBehaviorSolver()  { }
 
   virtual List<MixedBehaviorProfile<T> > Solve(const BehaviorSupportProfile &) const;
 
 private:
   int m_stopAfter, m_maxDepth;
+  bool m_sparse;
 
   class Solution;
 
-  void FillTableau(const BehaviorSupportProfile &, Matrix<T> &, const GameNode &, T,
+  template <class Tableau>
+  void FillTableau(const BehaviorSupportProfile &, Tableau &, int, T,
 		   int, int, int, int, Solution &) const;
   void AllLemke(const BehaviorSupportProfile &, int dup, Gambit::linalg::LemkeTableau<T> &B,
 	       int depth, Matrix<T> &, Solution &) const; 
-  void GetProfile(const BehaviorSupportProfile &, const Gambit::linalg::LemkeTableau<T> &tab, 
+  template <class Tableau>
+  void GetProfile(const BehaviorSupportProfile &, const Tableau &tab, 
 		  MixedBehaviorProfile<T> &, const Vector<T> &, 
-		  const GameNode &n, int, int,
+		  int n, int, int,
 		  Solution &) const;
+  void SolveSparse(const BehaviorSupportProfile &, Solution &) const;
 };
 
 }  // end namespace Nash
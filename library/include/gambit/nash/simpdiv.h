@@ -27,6 +27,44 @@
 
 namespace Gambit {
 namespace Nash {
+
+///
+/// The progress of a run of simplicial subdivision from a starting point,
+/// as of the end of a grid level.  The profile is the approximation found
+/// on the last grid searched, or the starting point if none has been; the
+/// next level searches a grid finer by the solver's refinement factor.
+/// The probabilities are held apart from any game object, so that a run
+/// can be continued on a copy of the game, or written to a stream and
+/// read back to resume a run which was interrupted.
+///
+class SimpdivCheckpoint {
+public:
+  SimpdivCheckpoint(void) : m_levels(0), m_finished(false) { }
+  /// Creates a checkpoint for a run from the starting point
+  explicit SimpdivCheckpoint(const MixedStrategyProfile<Rational> &);
+
+  /// Returns the profile reached, on the game (or a copy of it)
+  MixedStrategyProfile<Rational> GetProfile(const Game &) const;
+  /// Returns the spacing of the last grid searched
+  const Rational &GetGrid(void) const { return m_grid; }
+  /// Returns the number of grid levels searched
+  int NumLevels(void) const { return m_levels; }
+  /// Returns true if the profile reached approximates an equilibrium
+  bool IsFinished(void) const { return m_finished; }
+
+  /// Writes the checkpoint on one line of the stream
+  void Write(std::ostream &) const;
+  /// Reads a checkpoint written by Write()
+  void Read(std::istream &);
+
+private:
+  friend class NashSimpdivStrategySolver;
+
+  Array<Rational> m_probs;
+  Rational m_grid;
+  int m_levels;
+  bool m_finished;
+};
   
 ///
 /// This is a simplicial subdivision algorithm with restart, for finding
@@ -48,29 +86,76 @@ public:
   List<MixedStrategyProfile<Rational> > Solve(const MixedStrategyProfile<Rational> &p_start) const;
   List<MixedStrategyProfile<Rational> > Solve(const Game &p_game) const;
 
+  /// Continues the run on the game by searching the next grid level,
+  /// updating the checkpoint.  Returns true if the run is finished.
+  bool Refine(const Game &p_game, SimpdivCheckpoint &p_run) const;
+  /// Continues the run on the game until it is finished
+  List<MixedStrategyProfile<Rational> > Solve(const Game &p_game,
+					      SimpdivCheckpoint &p_run) const;
+
 
 private:
   int m_gridResize, m_leashLength;
   bool m_verbose;
 
+  ///
+  /// The state of the search, and the evaluation of labels at the
+  /// vertices of the grid.  Vertices are given by their integer
+  /// coordinates on a grid with a common denominator.  For table games,
+  /// the values of strategies at a vertex are held as integers, scaled
+  /// by the denominator and the lcd of the payoffs, and are updated from
+  /// those at the previous vertex; for other games they are computed
+  /// from the profile.
+  ///
   class State {
   public:
     int t, ibar;
-    Rational d, pay, maxz, bestz;
-    
-    State(void) : t(0), ibar(1), bestz(1.0e30) { }
-    Rational getlabel(MixedStrategyProfile<Rational> &yy, Array<int> &, 
-		      PVector<Rational> &);
+
+    State(const Game &);
+
+    /// Starts a search on the grid with the given denominator
+    void Reset(const Integer &p_denom);
+    /// Computes the label of the vertex; returns true if the vertex is
+    /// the closest to an equilibrium found so far
+    bool getlabel(const PVector<Integer> &y, Array<int> &ylabel);
+    /// Returns the largest regret at the best vertex found
+    Rational GetBestRegret(void) const;
+
+  private:
+    Game m_game;
+    Integer m_denom;
+    bool m_haveBest;
+    Rational m_bestz;
+
+    // Used for table games
+    bool m_isTable;
+    Array<int> m_numStrats;
+    Array<long> m_strides;
+    Array<std::vector<Integer> > m_payoffs;
+    Integer m_lcd, m_bestScaled;
+    PVector<Integer> m_vertex, m_values;
+    bool m_valuesValid;
+    std::vector<Integer> m_work1, m_work2, m_delta;
+
+    // Used for other games
+    MixedStrategyProfile<Rational> m_profile;
+
+    void Contract(int pl, int p_first, const Integer *p_weights,
+		  std::vector<Integer> &p_result);
+    void ComputeValues(const PVector<Integer> &);
+    void UpdateValues(const PVector<Integer> &);
+    bool TableLabel(const PVector<Integer> &, Array<int> &);
+    bool ProfileLabel(const PVector<Integer> &, Array<int> &);
   };
 
-  Rational Simplex(MixedStrategyProfile<Rational> &, const Rational &d) const;
-  void update(State &, RectArray<int> &, RectArray<int> &, PVector<Rational> &,
+  Rational Simplex(State &, MixedStrategyProfile<Rational> &, 
+		   const Rational &d) const;
+  void update(State &, RectArray<int> &, RectArray<int> &, PVector<int> &,
 	      const PVector<int> &, int j, int i) const;
-  void getY(State &, MixedStrategyProfile<Rational> &x, PVector<Rational> &, 
+  void getY(State &, PVector<Integer> &x, const PVector<Integer> &, 
 	    const PVector<int> &, const PVector<int> &, 
-	    const PVector<Rational> &, const RectArray<int> &, int k) const;
-  void getnexty(State &, 
-		MixedStrategyProfile<Rational> &x, const RectArray<int> &,
+	    const PVector<int> &, const RectArray<int> &, int k) const;
+  void getnexty(State &, PVector<Integer> &x, const RectArray<int> &,
 		const PVector<int> &, int i) const;
   int get_c(int j, int h, int nstrats, const PVector<int> &) const;
   int get_b(int j, int h, int nstrats, const PVector<int> &) const;
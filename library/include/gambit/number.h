@@ -39,6 +39,12 @@ public:
     : m_text(p_text), m_rational(lexical_cast<Rational>(p_text)), 
       m_double((double) m_rational)
   { }
+  /// Constructs the number from a text already converted to its exact
+  /// and floating-point values, as when reading binary savefiles
+  Number(const std::string &p_text, const Rational &p_rational,
+	 double p_double)
+    : m_text(p_text), m_rational(p_rational), m_double(p_double)
+  { }
   
   Number &operator=(const std::string &p_text)
   {
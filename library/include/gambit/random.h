@@ -0,0 +1,85 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/include/gambit/random.h
+// Sources of pseudorandom numbers
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_RANDOM_H
+#define LIBGAMBIT_RANDOM_H
+
+#include <cstdlib>
+
+namespace Gambit {
+
+/// Abstract source of pseudorandom integers
+class RandomGenerator {
+public:
+  virtual ~RandomGenerator() { }
+
+  /// Returns the next number in the sequence, in the range [0, Max()]
+  virtual long Next(void) = 0;
+  /// Returns the largest number the generator produces
+  virtual long Max(void) const = 0;
+
+  /// Returns a number in the range [0, 1]
+  double Uniform(void) { return ((double) Next()) / ((double) Max()); }
+  /// Returns an integer in the range [0, p_range)
+  long Integer(long p_range) { return Next() % p_range; }
+};
+
+/// The generator of the C library.  Its state is shared by the whole
+/// process, so it should not be used when solving games concurrently.
+class StdRandomGenerator : public RandomGenerator {
+public:
+  virtual ~StdRandomGenerator() { }
+
+  virtual long Next(void) { return std::rand(); }
+  virtual long Max(void) const { return RAND_MAX; }
+};
+
+/// The "minimal standard" multiplicative congruential generator of
+/// Park and Miller (with multiplier 48271).  All of its state is held
+/// in the object, so each thread may use its own generator independently,
+/// and sequences are reproducible from the seed.
+class MinStdRandomGenerator : public RandomGenerator {
+private:
+  long m_state;
+
+public:
+  MinStdRandomGenerator(unsigned long p_seed = 1) { Seed(p_seed); }
+  virtual ~MinStdRandomGenerator() { }
+
+  /// Restart the sequence from the given seed
+  void Seed(unsigned long p_seed)
+  { m_state = (long) (p_seed % 2147483646UL) + 1; }
+
+  virtual long Next(void)
+  {
+    // Schrage's method computes 48271 * state mod (2^31 - 1) without
+    // overflowing 32-bit arithmetic
+    m_state = 48271L * (m_state % 44488L) - 3399L * (m_state / 44488L);
+    if (m_state < 0)  m_state += 2147483647L;
+    return m_state;
+  }
+  virtual long Max(void) const { return 2147483646L; }
+};
+
+}  // end namespace Gambit
+
+#endif  // LIBGAMBIT_RANDOM_H
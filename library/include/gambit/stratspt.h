@@ -43,6 +43,7 @@ class StrategySupportProfile;
 class StrategySupportProfile {
   template <class T> friend class MixedStrategyProfile;
   template <class T> friend class MixedStrategyProfileRep;
+  template <class T> friend class TableMixedStrategyProfileRep;
   template <class T> friend class AggMixedStrategyProfileRep;
   template <class T> friend class BagentMixedStrategyProfileRep;
 protected:
@@ -75,7 +76,7 @@ public:
   /// @name General information
   //@{
   /// Returns the game on which the support is defined.
-  Game GetGame(void) const { return m_nfg; }
+  const Game &GetGame(void) const { return m_nfg; }
 
   /// Returns the number of strategies in the support for player pl.
   int NumStrategies(int pl) const  { return m_support[pl].Length(); }
@@ -89,7 +90,7 @@ public:
   template <class T> MixedStrategyProfile<T> NewMixedStrategyProfile(void) const;
 
   /// Returns the strategy in the st'th position for player pl.
-  GameStrategy GetStrategy(int pl, int st) const 
+  const GameStrategy &GetStrategy(int pl, int st) const 
     { return m_support[pl][st]; }
 
   /// Returns the number of players in the game
@@ -177,7 +178,7 @@ public:
 
     /// @name Access to state information
     //@{
-    GameStrategy GetStrategy(void) const
+    const GameStrategy &GetStrategy(void) const
     { return support.GetStrategy(pl, strat); }
     int StrategyIndex(void) const { return strat; }
     GamePlayer GetPlayer(void) const
@@ -0,0 +1,94 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/include/gambit/symmetry.h
+// Classes of interchangeable players and symmetric strategy profiles
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef LIBGAMBIT_SYMMETRY_H
+#define LIBGAMBIT_SYMMETRY_H
+
+#include "gambit/gambit.h"
+
+namespace Gambit {
+
+/// \brief The classes of interchangeable players of a strategic game
+///
+/// Relates mixed strategy profiles in which all members of each class
+/// play the same strategy to reduced vectors, which hold one mixed
+/// strategy per class.  Full vectors are laid out as mixed strategy
+/// profiles, and reduced vectors likewise with classes in place of
+/// players.  Indices into both are 1-based.
+class PlayerClasses {
+private:
+  Array<int> m_classes, m_fullOffsets, m_reducedOffsets, m_numStrategies;
+  Array<Array<int> > m_members;
+  int m_fullLength, m_reducedLength;
+
+  void Initialize(const Game &);
+
+public:
+  /// @name Lifecycle
+  //@{
+  /// Construct from the classes reported by the game
+  explicit PlayerClasses(const Game &p_game)
+    : m_classes(p_game->GetPlayerClasses()) { Initialize(p_game); }
+  /// Construct from a given class number for each player
+  PlayerClasses(const Game &p_game, const Array<int> &p_classes)
+    : m_classes(p_classes) { Initialize(p_game); }
+  //@}
+
+  /// @name Data access
+  //@{
+  int NumClasses(void) const { return m_members.Length(); }
+  /// Returns the class of player pl
+  int GetClass(int pl) const { return m_classes[pl]; }
+  /// Returns the players in class cls, in increasing order
+  const Array<int> &GetMembers(int cls) const { return m_members[cls]; }
+  /// Returns the first member of class cls
+  int GetRepresentative(int cls) const { return m_members[cls][1]; }
+  /// Returns the number of strategies of each member of class cls
+  int NumStrategies(int cls) const { return m_numStrategies[cls]; }
+  /// Returns true if no two players are interchangeable
+  bool IsTrivial(void) const { return NumClasses() == m_classes.Length(); }
+
+  /// Returns the length of a mixed strategy profile
+  int FullLength(void) const { return m_fullLength; }
+  /// Returns the length of a reduced vector
+  int ReducedLength(void) const { return m_reducedLength; }
+  /// The position of the first strategy of player pl, less one
+  int FullOffset(int pl) const { return m_fullOffsets[pl]; }
+  /// The position of the first strategy of class cls, less one
+  int ReducedOffset(int cls) const { return m_reducedOffsets[cls]; }
+  //@}
+
+  /// @name Converting between full and reduced vectors
+  //@{
+  /// Each member of a class gets the entries of its class
+  Vector<double> Expand(const Vector<double> &p_reduced) const;
+  /// The entries of a class are the sums of those of its members;
+  /// this is the transpose of Expand, as used for gradients
+  Vector<double> Fold(const Vector<double> &p_full) const;
+  /// The entries of a class are the means of those of its members
+  Vector<double> Average(const Vector<double> &p_full) const;
+  //@}
+};
+
+}  // end namespace Gambit
+
+#endif  // LIBGAMBIT_SYMMETRY_H
@@ -27,6 +27,7 @@
 #include <sstream>
 #include <cassert>
 #include <algorithm>
+#include <numeric>
 #include "gambit/agg/gray.h"
 #include "gambit/agg/agg.h"
 
@@ -63,6 +64,8 @@ Pr(P),
 isPure(numANodes,true),
 node2Action(numANodes,vector<int>(numPlayers)),
 cache(numPlayers+1),
+fullP(numANodes),
+fullPValid(numANodes,false),
 player2Class(numPlayers),
 kSymStrategyOffset(1,0)
 {
@@ -135,6 +138,73 @@ kSymStrategyOffset(1,0)
 
 }
 
+AGG::AGG(const AGG& other) :
+numPlayers(other.numPlayers),
+totalActions(other.totalActions),
+maxActions(other.maxActions),
+numActionNodes(other.numActionNodes),
+numPNodes(other.numPNodes),
+actionSets(other.actionSets),
+neighbors(other.neighbors),
+projectionTypes(other.projectionTypes.size()),
+payoffs(other.payoffs.size()),
+projection(other.projection),
+projectedStrat(other.projectedStrat.size()),
+fullProjectedStrat(other.fullProjectedStrat.size()),
+projFunctions(other.numActionNodes),
+Porder(other.Porder),
+Pr(other.Pr.size()),
+isPure(other.isPure),
+node2Action(other.node2Action),
+cache(other.numPlayers+1),
+fullP(other.numActionNodes),
+fullPValid(other.numActionNodes,false),
+uniqueActionSets(other.uniqueActionSets),
+playerClasses(other.playerClasses),
+player2Class(other.player2Class),
+numKSymActions(other.numKSymActions),
+kSymStrategyOffset(other.kSymStrategyOffset)
+{
+  actions=new int[numPlayers];
+  strategyOffset= new int[numPlayers+1];
+  copy(other.actions, other.actions+numPlayers, actions);
+  copy(other.strategyOffset, other.strategyOffset+numPlayers+1, strategyOffset);
+
+  //the tries are copied in order, so that computations on the copy
+  //sum their terms in the same order as on the original
+  for (size_t i=0;i<payoffs.size();++i){
+    payoffs[i].assign_in_order(other.payoffs[i]);
+  }
+  for (size_t i=0;i<projectedStrat.size();++i){
+    projectedStrat[i].resize(other.projectedStrat[i].size());
+    for (size_t j=0;j<projectedStrat[i].size();++j){
+      projectedStrat[i][j].assign_in_order(other.projectedStrat[i][j]);
+    }
+  }
+  for (size_t i=0;i<fullProjectedStrat.size();++i){
+    fullProjectedStrat[i].resize(other.fullProjectedStrat[i].size());
+    for (size_t j=0;j<fullProjectedStrat[i].size();++j){
+      fullProjectedStrat[i][j].assign_in_order(other.fullProjectedStrat[i][j]);
+    }
+  }
+  for (size_t i=0;i<Pr.size();++i){
+    Pr[i].assign_in_order(other.Pr[i]);
+  }
+
+  for (size_t i=0;i<projectionTypes.size();++i){
+    projectionTypes[i]=other.projectionTypes[i]->clone();
+  }
+  //as when reading the game, neighbors which are action nodes are
+  //projected by summing, and function nodes by their own functions
+  for (int i=0;i<numActionNodes;i++){
+    int neighb_size=neighbors[i].size();
+    for(int j=0;j<neighb_size; j++){
+      projtype t=(neighbors[i][j]<numActionNodes)?(new proj_func_SUM):projectionTypes[neighbors[i][j]-numActionNodes];
+      projFunctions[i].push_back(t);
+    }
+  }
+}
+
 /*
 AGG::AGG(const agg& other, bool completeGraph)
 :
@@ -354,7 +424,10 @@ AGG *AGG::makeAGG(istream &in){
           for (int k=1; k<n;k++){
             Pr[k].multiply (Pr[k-1], projS[ASets[i][j]][Po[i][j][k]],proj[ASets[i][j]][i][j].size()  ,projF[ASets[i][j]] );
           }
-	  pays[ASets[i][j]].insert(Pr[n-1].begin(), Pr[n-1].end());
+	  for (aggdistrib::iterator p=Pr[n-1].begin(); p!=Pr[n-1].end(); ++p){
+	    pays[ASets[i][j]].insert(make_pair(config(p->first.begin(),p->first.end()),
+					       p->second));
+	  }
         }
         doneASets.insert(as);
       }
@@ -447,7 +520,10 @@ vector<projtype>& projTypes, int seed, bool int_payoffs, int int_factor){
           for (int k=1; k<n;k++){
             Pr[k].multiply (Pr[k-1], projS[ASets[i][j]][Po[i][j][k]],proj[ASets[i][j]][i][j].size()  ,projF[ASets[i][j]] );
           }
-          pays[ASets[i][j]].insert(Pr[n-1].begin(), Pr[n-1].end());
+          for (aggdistrib::iterator p=Pr[n-1].begin(); p!=Pr[n-1].end(); ++p){
+            pays[ASets[i][j]].insert(make_pair(config(p->first.begin(),p->first.end()),
+                                               p->second));
+          }
         }
         doneASets.insert(as);
       }
@@ -654,17 +730,175 @@ AggNumber AGG::getPurePayoff(int player, int *s){
 AggNumber AGG::getMixedPayoff(int player, StrategyProfile &s){
   AggNumber result=0.0;
   assert(player>=0 && player < numPlayers);
+  AggNumberVector values(actions[player]);
+  getPayoffs(values, player, &s[0], true);
   for (int act=0;act <actions[player];++act)if (s[act+firstAction(player)]>(AggNumber)0.0){
-	result+= s[act+firstAction(player)]* getV(player, act, s);
+	result+= s[act+firstAction(player)]* values[act];
   }
   return result;
 }
 
 void AGG::getPayoffVector(AggNumberVector &dest, int player,const StrategyProfile &s){
     assert(player>=0 && player < numPlayers);
-    for (int act=0;act<actions[player]; ++act){
-	dest[act]=getV(player,act,s);
+    getPayoffs(dest, player, &s[0], false);
+}
+
+//compute the payoffs to player's actions (if supportOnly, only those
+//played with positive probability) into dest.  The actions whose nodes
+//have the same neighbors face the same distribution of the others'
+//configurations, which is computed once for each such class; so is the
+//distribution at a node from which it can be obtained by division.
+//Otherwise, the distribution including the player's own action is
+//computed directly, as in getV().
+void AGG::getPayoffs(AggNumberVector &dest, int player, const AggNumber *s,
+		     bool supportOnly)
+{
+  vector<pair<vector<int>,int> > classes;
+  for (int act=0;act<actions[player];++act){
+    if (!supportOnly || s[act+firstAction(player)]>(AggNumber)0.0){
+      classes.push_back(make_pair(neighbors[actionSets[player][act]], act));
     }
+  }
+  sort(classes.begin(),classes.end());
+
+  bool haveOthers=false;
+  for (size_t i=0;i<classes.size();++i){
+    int act=classes[i].second;
+    int Node=actionSets[player][act];
+    bool first=(i==0 || classes[i].first!=classes[i-1].first);
+    bool shared=(!first || (i+1<classes.size() &&
+			    classes[i+1].first==classes[i].first));
+    if (first){
+      haveOthers=(isPure[Node] && divideFullP(Node,player,s));
+      if (!haveOthers && shared){
+	computeOthersP(player,act,s);
+	haveOthers=true;
+      }
+    }
+    if (haveOthers){
+      dest[act]=Pr[numPlayers-1].inner_prod(projection[Node][player][act],
+					    neighbors[Node].size(),
+					    projFunctions[Node], payoffs[Node]);
+    }
+    else {
+      doProjection(Node, const_cast<AggNumber *>(s));
+      computeP(player, act);
+      dest[act]=Pr[numPlayers-1].inner_prod(payoffs[Node]);
+    }
+  }
+}
+
+//compute in Pr[numPlayers-1] the distribution induced at the node of
+//player's action act by the strategies of the other players in s.
+void AGG::computeOthersP(int player, int act, const AggNumber *s)
+{
+  int Node=actionSets[player][act];
+  doProjection(Node, const_cast<AggNumber *>(s));
+  int numNei = neighbors[Node].size();
+  vector<int> &order = Porder[player][act];
+  if (numPlayers==1){
+    Pr[0].reset();
+    Pr[0].insert(make_pair(config(numNei,0), 1.0));
+    return;
+  }
+  Pr[1]=projectedStrat[Node][order[1]];
+  for (int k=2;k<numPlayers;k++){
+    Pr[k].multiply(Pr[k-1], projectedStrat[Node][order[k]],
+		   numNei, projFunctions[Node]);
+  }
+}
+
+//divide the distribution induced at Node, whose neighbors are all
+//action nodes, by all players in s by player's projected strategy,
+//storing the result in Pr[numPlayers-1].  The distribution induced by
+//all players is kept for the profile, and so shared by all players'
+//actions at the node.  Dividing costs about as much as one multiplication of the full
+//distribution, while computing the others' distribution directly takes
+//numPlayers-2 multiplications of distributions which grow with the
+//number of neighbors; so the full distribution is used only if there are
+//many players compared to the number of neighbors.
+bool AGG::divideFullP(int Node, int player, const AggNumber *s)
+{
+  int numNei = neighbors[Node].size();
+  if (numPlayers < 2*(numNei+1)) return false;
+
+  if ((int)fullProfile.size()!=totalActions ||
+      !equal(fullProfile.begin(),fullProfile.end(),s)){
+    fullProfile.assign(s, s+totalActions);
+    fill(fullPValid.begin(),fullPValid.end(),false);
+  }
+  aggdistrib &P=fullP[Node];
+  if (!fullPValid[Node]){
+    doProjection(Node, const_cast<AggNumber *>(s));
+    aggdistrib temp;
+    P.reset();
+    P.insert(make_pair(config(numNei,0), 1.0));
+    for (int i=0;i<numPlayers;i++){
+      temp.multiply(P, projectedStrat[Node][i], numNei, projFunctions[Node]);
+      P.swap(temp);
+    }
+    fullPValid[Node]=true;
+  }
+  else {
+    doProjection(Node, player, const_cast<AggNumber *>(s)+firstAction(player));
+  }
+  return divide(Pr[numPlayers-1], P, projectedStrat[Node][player], numNei);
+}
+
+//divide the distribution P at a node whose neighbors are all action
+//nodes by the projected strategy d, storing the result in dest.
+//Since the projections are summed, the quotient Q satisfies
+//  Q(c) = (P(c) - sum_{e != 0} d(e) Q(c-e)) / d(0),
+//which is computed in increasing order of the total count of c.  This
+//is stable only if d(0) is at least the sum of the other terms of d;
+//otherwise nothing is done, and false is returned.
+bool AGG::divide(aggdistrib &dest, const aggdistrib &P, const aggdistrib &d,
+		 int numNei)
+{
+  AggNumber null_prob=0.0, rest=0.0;
+  int maxCount=0;
+  vector<aggdistrib::const_iterator> terms;
+  for (aggdistrib::const_iterator p=d.begin(); p!=d.end(); ++p){
+    int count=accumulate(p->first.begin(),p->first.end(),0);
+    if (count==0) null_prob+=p->second;
+    else {
+      rest+=p->second;
+      terms.push_back(p);
+    }
+    maxCount=max(maxCount,count);
+  }
+  if (null_prob<=(AggNumber)0.0 || null_prob<rest) return false;
+
+  //sort the terms of P by their total count
+  vector<vector<aggdistrib::const_iterator> > byCount;
+  for (aggdistrib::const_iterator p=P.begin(); p!=P.end(); ++p){
+    size_t count=accumulate(p->first.begin(),p->first.end(),0);
+    if (count>=byCount.size()) byCount.resize(count+1);
+    byCount[count].push_back(p);
+  }
+
+  dest.reset();
+  config c(numNei);
+  for (int count=0;count+maxCount<(int)byCount.size();++count){
+    for (size_t t=0;t<byCount[count].size();++t){
+      const aggdistrib::key_ref &key=byCount[count][t]->first;
+      AggNumber v=byCount[count][t]->second;
+      for (size_t e=0;e<terms.size();++e){
+	bool valid=false;
+	for (int k=0;k<numNei;++k){
+	  c[k]=key[k]-terms[e]->first[k];
+	  if (c[k]<0) break;
+	  valid=(k==numNei-1);
+	}
+	if (!valid) continue;
+	aggdistrib::iterator q=dest.find(c);
+	if (q!=dest.end()) v-=terms[e]->second*q->second;
+      }
+      c.assign(key.begin(),key.end());
+      dest.insert(make_pair(c, v/null_prob));
+    }
+  }
+  return true;
 }
 
 AggNumber AGG::getV(int player, int act,const StrategyProfile &s){
@@ -925,9 +1159,7 @@ AggNumber AGG::getKSymMixedPayoff(int playerClass, int act, vector<StrategyProfi
       
       int numNei = neighbors[uniqueActionSets[playerClass][act]].size();
 
-      static aggdistrib d,temp;
-      d.reset();
-      temp.reset();
+      aggdistrib d,temp;
       getSymConfigProb(0, s[0], playerClass, act, d);
       for(int pc=1;pc<numPC;pc++){
 	  getSymConfigProb(pc, s[pc], playerClass, act, temp);
@@ -939,7 +1171,7 @@ AggNumber AGG::getKSymMixedPayoff(int playerClass, int act, vector<StrategyProfi
 AggNumber AGG::getKSymMixedPayoff(const StrategyProfile &s,int pClass1,int act1,int pClass2,int act2){
   int numPC=playerClasses.size();
   int numNei=neighbors[uniqueActionSets[pClass1][act1]].size();
-  static aggdistrib d,temp;
+  aggdistrib d,temp;
   if (pClass2>=0 && pClass1==pClass2 && playerClasses.at(pClass1).size()<=1){
     return 0;
   }
@@ -1065,28 +1297,19 @@ void AGG::makeMAPPINGpayoff(std::istream& in, aggpayoff& pay, int numNei){
 }
 
 AggNumber AGG::getMaxPayoff(){
-  static bool done=false;
-  static AggNumber result=0;
-  if (done)return result;
   assert(numActionNodes>0);
-  result=payoffs[0].begin()->second;
-  for (int i=1;i<numActionNodes;i++)
+  AggNumber result=payoffs[0].begin()->second;
+  for (int i=0;i<numActionNodes;i++)
     for (aggpayoff::iterator it=payoffs[i].begin();it!=payoffs[i].end();++it)
       result=max(result, it->second);
-
-  done=true;
   return result;
 }
 AggNumber AGG::getMinPayoff(){
-  static bool done=false;
-  static AggNumber result=0;
-  if (done)return result;
   assert(numActionNodes>0);
-  result=payoffs[0].begin()->second;
-  for (int i=1;i<numActionNodes;i++)
+  AggNumber result=payoffs[0].begin()->second;
+  for (int i=0;i<numActionNodes;i++)
       for (aggpayoff::iterator it=payoffs[i].begin();it!=payoffs[i].end();++it)
         result=min(result, it->second);
-  done=true;
   return result;
 }
 
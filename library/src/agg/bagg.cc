@@ -47,6 +47,22 @@ BAGG::BAGG(int N, int S,
   }
 }
 
+BAGG::BAGG(const BAGG& other):
+  numPlayers(other.numPlayers),
+  numActionNodes(other.numActionNodes),
+  numTypes(other.numTypes),
+  indepTypeDist(other.indepTypeDist),
+  typeActionSets(other.typeActionSets),
+  typeAction2ActionIndex(other.typeAction2ActionIndex),
+  aggPtr(new AGG(*other.aggPtr)),
+  symmetric(other.symmetric)
+{
+  typeOffset=new int[numPlayers+1];
+  copy(other.typeOffset, other.typeOffset+numPlayers+1, typeOffset);
+  strategyOffset=new int[typeOffset[numPlayers]+1];
+  copy(other.strategyOffset, other.strategyOffset+typeOffset[numPlayers]+1,
+       strategyOffset);
+}
 
 void BAGG::stripComment(istream& in){
   in>>ws;
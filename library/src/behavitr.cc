@@ -32,7 +32,7 @@ BehaviorProfileIterator::BehaviorProfileIterator(const BehaviorSupportProfile &p
     m_numActiveInfosets(m_support.GetGame()->NumPlayers())
 {
   for (int pl = 1; pl <= m_support.GetGame()->NumPlayers(); pl++) {
-    GamePlayer player = m_support.GetGame()->GetPlayer(pl);
+    GameObjectRef<GamePlayerRep> player = m_support.GetGame()->Players()[pl];
     m_numActiveInfosets[pl] = 0;
     Array<bool> activeForPl(player->NumInfosets());
     for (int iset = 1; iset <= player->NumInfosets(); iset++) {
@@ -54,7 +54,7 @@ BehaviorProfileIterator::BehaviorProfileIterator(const BehaviorSupportProfile &p
     m_numActiveInfosets(m_support.GetGame()->NumPlayers())
 {
   for (int pl = 1; pl <= m_support.GetGame()->NumPlayers(); pl++) {
-    GamePlayer player = m_support.GetGame()->GetPlayer(pl);
+    GameObjectRef<GamePlayerRep> player = m_support.GetGame()->Players()[pl];
     m_numActiveInfosets[pl] = 0;
     Array<bool> activeForPl(player->NumInfosets());
     for (int iset = 1; iset <= player->NumInfosets(); iset++) {
@@ -73,7 +73,7 @@ BehaviorProfileIterator::BehaviorProfileIterator(const BehaviorSupportProfile &p
 void BehaviorProfileIterator::First(void)
 {
   for (int pl = 1; pl <= m_support.GetGame()->NumPlayers(); pl++)  {
-    for (int iset = 1; iset <= m_support.GetGame()->GetPlayer(pl)->NumInfosets(); iset++) {
+    for (int iset = 1; iset <= m_support.GetGame()->Players()[pl]->NumInfosets(); iset++) {
       if (pl != m_frozenPlayer && iset != m_frozenInfoset) {
 	m_currentBehav(pl, iset) = 1;
 	if (m_isActive[pl][iset]) {
@@ -94,7 +94,7 @@ void BehaviorProfileIterator::operator++(void)
     return;
   }
 
-  int iset = m_support.GetGame()->GetPlayer(pl)->NumInfosets();
+  int iset = m_support.GetGame()->Players()[pl]->NumInfosets();
     
   while (true) {
     if (m_isActive[pl][iset] && 
@@ -120,7 +120,7 @@ void BehaviorProfileIterator::operator++(void)
 	m_atEnd = true;
 	return;
       }
-      iset = m_support.GetGame()->GetPlayer(pl)->NumInfosets();
+      iset = m_support.GetGame()->Players()[pl]->NumInfosets();
     }
   }
 }
@@ -0,0 +1,266 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/src/binfile.cc
+// Encoding and decoding of binary game savefiles
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <cstring>
+#include <iostream>
+#include <sstream>
+
+#include "gambit/gambit.h"
+#include "gambit/binfile.h"
+#include "gambit/gametable.h"
+#include "gambit/gametree.h"
+
+namespace Gambit {
+
+namespace {
+
+const char BINARY_SIGNATURE[8] = { 'G', 'A', 'M', 'B', 'I', 'T', 'B', 'F' };
+const unsigned int BINARY_VERSION = 1;
+const unsigned int BINARY_BYTE_ORDER = 0x01020304;
+
+/// Marks an integer too large for 64 bits, stored by its text instead
+const long long BINARY_BIG_INTEGER = -9223372036854775807LL - 1;
+
+void AppendWord(std::string &p_buffer, unsigned int p_value)
+{
+  unsigned int word = p_value;
+  p_buffer.append(reinterpret_cast<const char *>(&word), sizeof(word));
+}
+
+} // end anonymous namespace
+
+bool IsBinaryGameFile(const char *p_begin, const char *p_end)
+{
+  return (p_end - p_begin >= (long) sizeof(BINARY_SIGNATURE) &&
+	  !memcmp(p_begin, BINARY_SIGNATURE, sizeof(BINARY_SIGNATURE)));
+}
+
+Game ReadBinaryGame(const char *p_begin, const char *p_end)
+{
+  BinaryFileReader reader(p_begin, p_end);
+  switch (reader.GetKind()) {
+  case BINARY_GAME_TABLE:
+    return GameTableRep::ReadBinaryFile(reader);
+  case BINARY_GAME_TREE:
+    return GameTreeRep::ReadBinaryFile(reader);
+  default:
+    throw InvalidFileException("Unknown kind of game in binary savefile");
+  }
+}
+
+//========================================================================
+//                      class BinaryFileWriter
+//========================================================================
+
+unsigned int BinaryFileWriter::StringIndex(const std::string &p_text)
+{
+  std::map<std::string, unsigned int>::const_iterator it =
+    m_stringIndex.find(p_text);
+  if (it != m_stringIndex.end()) {
+    return it->second;
+  }
+  m_strings.push_back(p_text);
+  return (m_stringIndex[p_text] = m_strings.size() - 1);
+}
+
+void BinaryFileWriter::WriteCount(unsigned int p_value)
+{
+  AppendWord(m_body, p_value);
+}
+
+void BinaryFileWriter::WriteString(const std::string &p_text)
+{
+  AppendWord(m_body, StringIndex(p_text));
+}
+
+void BinaryFileWriter::WriteNumber(const Number &p_value)
+{
+  const std::string &text = p_value;
+  std::map<std::string, unsigned int>::const_iterator it =
+    m_valueIndex.find(text);
+  if (it != m_valueIndex.end()) {
+    AppendWord(m_body, it->second);
+    return;
+  }
+  // Make sure the text of the value is in the string table before it
+  // is written out.
+  StringIndex(text);
+  m_values.push_back(p_value);
+  AppendWord(m_body, m_valueIndex[text] = m_values.size() - 1);
+}
+
+void BinaryFileWriter::Flush(std::ostream &p_file) const
+{
+  std::string header(BINARY_SIGNATURE, sizeof(BINARY_SIGNATURE));
+  AppendWord(header, BINARY_VERSION);
+  AppendWord(header, BINARY_BYTE_ORDER);
+  AppendWord(header, m_kind);
+
+  // Integers too large to be stored directly refer to their text in
+  // the string table; these are collected while writing the values,
+  // and so the string table is written after them.
+  std::vector<std::string> strings(m_strings);
+  std::map<std::string, unsigned int> stringIndex(m_stringIndex);
+  std::string values;
+  AppendWord(values, m_values.size());
+  for (size_t i = 0; i < m_values.size(); i++) {
+    const std::string &text = m_values[i];
+    AppendWord(values, stringIndex.find(text)->second);
+    double d = m_values[i];
+    values.append(reinterpret_cast<const char *>(&d), sizeof(d));
+    const Rational &r = m_values[i];
+    const Integer *parts[2] = { &r.numerator(), &r.denominator() };
+    for (int j = 0; j < 2; j++) {
+      long long value = (parts[j]->fits_in_long()) ?
+	parts[j]->as_long() : BINARY_BIG_INTEGER;
+      if (value != BINARY_BIG_INTEGER) {
+	values.append(reinterpret_cast<const char *>(&value), sizeof(value));
+      }
+      else {
+	values.append(reinterpret_cast<const char *>(&BINARY_BIG_INTEGER),
+		      sizeof(BINARY_BIG_INTEGER));
+	std::string digits = Itoa(*parts[j], 10, 0);
+	if (!stringIndex.count(digits)) {
+	  strings.push_back(digits);
+	  stringIndex[digits] = strings.size() - 1;
+	}
+	AppendWord(values, stringIndex[digits]);
+      }
+    }
+  }
+
+  AppendWord(header, strings.size());
+  for (size_t i = 0; i < strings.size(); i++) {
+    AppendWord(header, strings[i].size());
+    header += strings[i];
+  }
+
+  p_file.write(header.data(), header.size());
+  p_file.write(values.data(), values.size());
+  p_file.write(m_body.data(), m_body.size());
+}
+
+//========================================================================
+//                      class BinaryFileReader
+//========================================================================
+
+BinaryFileReader::BinaryFileReader(const char *p_begin, const char *p_end)
+  : m_current(p_begin), m_end(p_end)
+{
+  if (!IsBinaryGameFile(p_begin, p_end)) {
+    throw InvalidFileException("Not a binary game savefile");
+  }
+  m_current += sizeof(BINARY_SIGNATURE);
+  if (ReadCount() != BINARY_VERSION) {
+    throw InvalidFileException("Unsupported version of binary savefile");
+  }
+  if (ReadCount() != BINARY_BYTE_ORDER) {
+    throw InvalidFileException("Binary savefile written with a different byte order");
+  }
+  m_kind = (BinaryGameKind) ReadCount();
+
+  unsigned int numStrings = ReadCount();
+  for (unsigned int i = 0; i < numStrings; i++) {
+    unsigned int length = ReadCount();
+    if (length > (unsigned long) (m_end - m_current)) {
+      throw InvalidFileException("Binary savefile is truncated");
+    }
+    m_strings.push_back(std::string(m_current, length));
+    m_current += length;
+  }
+
+  unsigned int numValues = ReadCount();
+  for (unsigned int i = 0; i < numValues; i++) {
+    const std::string &text = ReadString();
+    double d;
+    Read(&d, sizeof(d));
+    Integer num = ReadInteger();
+    Integer den = ReadInteger();
+    if (den <= 0) {
+      throw InvalidFileException("Invalid value in binary savefile");
+    }
+    m_values.push_back(Number(text, Rational(num, den), d));
+  }
+}
+
+void BinaryFileReader::Read(void *p_data, size_t p_size)
+{
+  if (p_size > (unsigned long) (m_end - m_current)) {
+    throw InvalidFileException("Binary savefile is truncated");
+  }
+  memcpy(p_data, m_current, p_size);
+  m_current += p_size;
+}
+
+Integer BinaryFileReader::ReadInteger(void)
+{
+  long long value;
+  Read(&value, sizeof(value));
+  if (value == BINARY_BIG_INTEGER) {
+    return Integer(atoIntegerRep(ReadString().c_str(), 10));
+  }
+  else if ((long long) (long) value == value) {
+    return Integer((long) value);
+  }
+  else {
+    // The value does not fit in a long on this platform
+    std::ostringstream digits;
+    digits << value;
+    return Integer(atoIntegerRep(digits.str().c_str(), 10));
+  }
+}
+
+unsigned int BinaryFileReader::ReadCount(void)
+{
+  unsigned int value;
+  Read(&value, sizeof(value));
+  return value;
+}
+
+unsigned int BinaryFileReader::ReadCount(unsigned int p_max)
+{
+  unsigned int value = ReadCount();
+  if (value > p_max) {
+    throw InvalidFileException("Invalid index in binary savefile");
+  }
+  return value;
+}
+
+const std::string &BinaryFileReader::ReadString(void)
+{
+  unsigned int index = ReadCount();
+  if (index >= m_strings.size()) {
+    throw InvalidFileException("Invalid string index in binary savefile");
+  }
+  return m_strings[index];
+}
+
+const Number &BinaryFileReader::ReadNumber(void)
+{
+  unsigned int index = ReadCount();
+  if (index >= m_values.size()) {
+    throw InvalidFileException("Invalid value index in binary savefile");
+  }
+  return m_values[index];
+}
+
+}  // end namespace Gambit
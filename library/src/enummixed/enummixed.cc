@@ -20,6 +20,9 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <vector>
+#include <algorithm>
+
 #include "gambit/gambit.h"
 #include "gambit/linalg/vertenum.imp"
 #include "gambit/nash/enummixed.h"
@@ -30,6 +33,14 @@ namespace Nash {
 
 using namespace Gambit::linalg;
 
+namespace {
+
+/// A set of indices of vertices, as a bitset
+typedef std::vector<unsigned long> VertexSet;
+const int WORD_BITS = 8 * sizeof(unsigned long);
+
+}  // end anonymous namespace
+
 template <class T> List<List<MixedStrategyProfile<T> > > 
 EnumMixedStrategySolution<T>::GetCliques(void) const
 {
@@ -117,9 +128,12 @@ EnumMixedStrategySolver<T>::SolveDetailed(const Game &p_game) const
   b1 = (T) -1;
   b2 = (T) -1;
 
-  // enumerate vertices of A1 x + b1 <= 0 and A2 x + b2 <= 0
-  VertexEnumerator<T> poly1(A1, b1);
-  VertexEnumerator<T> poly2(A2, b2);
+  // enumerate vertices of A1 x + b1 <= 0 and A2 x + b2 <= 0,
+  // searching both polytopes with one pool of threads
+  VertexSearchPool<T> pool;
+  VertexEnumerator<T> poly1(A1, b1, &pool);
+  VertexEnumerator<T> poly2(A2, b2, &pool);
+  pool.Run();
 
   const List<BFS<T> > &verts1(poly1.VertexList());
   const List<BFS<T> > &verts2(poly2.VertexList());
@@ -131,25 +145,69 @@ EnumMixedStrategySolver<T>::SolveDetailed(const Game &p_game) const
   for (int i = 1; i <= vert1id.Length(); vert1id[i++] = 0);
   for (int i = 1; i <= vert2id.Length(); vert2id[i++] = 0);
 
-  int i = 0;
   int id1 = 0, id2 = 0;
+  int n1 = p_game->Players()[1]->Strategies().size();
+  int n2 = p_game->Players()[2]->Strategies().size();
 
+  // Index the vertices of polytope 1 by their labels, so as to find
+  // the vertices complementary to each vertex of polytope 2 without
+  // checking every pair.  A variable is a label of a vertex if its
+  // value is large enough that its product with any other label is
+  // not zero; two vertices sharing a complementary pair of labels
+  // are then not an equilibrium.  For each variable there is a bitset
+  // of the vertices of polytope 1 having it as a label.
+  std::vector<const BFS<T> *> bfs1s(solution->m_v1 + 1);
+  for (int i1 = 1; i1 <= solution->m_v1; i1++) {
+    bfs1s[i1] = &verts1[i1];
+  }
+  int words = solution->m_v1 / WORD_BITS + 1;
+  std::vector<VertexSet> slack1(n1 + 1, VertexSet(words, 0ul));
+  std::vector<VertexSet> prob1(n2 + 1, VertexSet(words, 0ul));
+  for (int i1 = 2; i1 <= solution->m_v1; i1++) {
+    const BFS<T> &bfs2 = *bfs1s[i1];
+    unsigned long bit = 1ul << (i1 % WORD_BITS);
+    for (int k = 1; k <= n1; k++) {
+      if (IsLabel(bfs2[-k]))  slack1[k][i1 / WORD_BITS] |= bit;
+    }
+    for (int k = 1; k <= n2; k++) {
+      if (IsLabel(bfs2[k]))  prob1[k][i1 / WORD_BITS] |= bit;
+    }
+  }
+
+  VertexSet excluded(words);
   for (int i2 = 2; i2 <= solution->m_v2; i2++) {
-    BFS<T> bfs1 = verts2[i2];
-    i++;
+    const BFS<T> &bfs1 = verts2[i2];
+    std::fill(excluded.begin(), excluded.end(), 0ul);
+    for (int k = 1; k <= n1; k++) {
+      if (IsLabel(bfs1[k])) {
+	for (int w = 0; w < words; w++)  excluded[w] |= slack1[k][w];
+      }
+    }
+    for (int k = 1; k <= n2; k++) {
+      if (IsLabel(bfs1[-k])) {
+	for (int w = 0; w < words; w++)  excluded[w] |= prob1[k][w];
+      }
+    }
+
     for (int i1 = 2; i1 <= solution->m_v1; i1++) {
-      BFS<T> bfs2 = verts1[i1];
+      if (excluded[i1 / WORD_BITS] == ~0ul) {
+	// skip to the end of the word
+	i1 = (i1 / WORD_BITS + 1) * WORD_BITS - 1;
+	continue;
+      }
+      if (excluded[i1 / WORD_BITS] & (1ul << (i1 % WORD_BITS)))  continue;
+      const BFS<T> &bfs2 = *bfs1s[i1];
 	
       // check if solution is nash 
       // need only check complementarity, since it is feasible
       bool nash = true;
-      for (int k = 1; nash && k <= p_game->Players()[1]->Strategies().size(); k++) {
+      for (int k = 1; nash && k <= n1; k++) {
 	if (bfs1.count(k) && bfs2.count(-k)) {
 	  nash = nash && EqZero(bfs1[k] * bfs2[-k]);
 	}
       }
 
-      for (int k = 1; nash && k <= p_game->Players()[2]->Strategies().size(); k++) {
+      for (int k = 1; nash && k <= n2; k++) {
 	if (bfs2.count(k) && bfs1.count(-k)) {
 	  nash = nash && EqZero(bfs2[k] * bfs1[-k]);
 	}
@@ -40,6 +40,9 @@
 #include <iostream>
 #include <cstdio>
 #include <cstring>
+#ifdef _OPENMP
+#include <omp.h>
+#endif  // _OPENMP
 
 // The order of these next includes is important, because of macro definitions
 #include "gambit/gambit.h"
@@ -58,8 +61,57 @@ namespace Nash {
 // rather than as private member functions of the solver class.
 namespace {
 
+//
+// lrslib keeps its bookkeeping (the list of allocated problems, the
+// precision of the arithmetic, and output streams) in global variables,
+// so only one solve may be using it at any time.  Solves in different
+// threads wait for each other here.
+//
+class LrsLock {
+public:
+#ifdef _OPENMP
+  LrsLock(void)  { omp_init_lock(&m_lock); }
+  ~LrsLock()  { omp_destroy_lock(&m_lock); }
+  void Set(void)  { omp_set_lock(&m_lock); }
+  void Unset(void)  { omp_unset_lock(&m_lock); }
+private:
+  omp_lock_t m_lock;
+#else
+  void Set(void)  { }
+  void Unset(void)  { }
+#endif  // _OPENMP
+};
+
+LrsLock lrsLock;
+
+/// Holds the lock for the lifetime of the object
+class LrsLockGuard {
+public:
+  LrsLockGuard(void)  { lrsLock.Set(); }
+  ~LrsLockGuard()  { lrsLock.Unset(); }
+};
+
+//
+// The state carried from one call of getabasis2 (and nash2_main) to
+// the next during a single solve.  In lrslib's nash.c these are static
+// local variables, which prevents solving more than one game per process.
+//
+class Nash2State {
+public:
+  long firsttime;
+  long *linindex;
+  long firstwarning;    /* FALSE if dual deg warning for Q2 already given     */
+  long firstunbounded;  /* FALSE if unbounded warning for Q2 already given    */
+
+  Nash2State(void)
+    : firsttime(TRUE), linindex(0), firstwarning(TRUE), firstunbounded(TRUE)
+  { }
+  ~Nash2State()  { free(linindex); }
+};
+
 long 
-getabasis2 (lrs_dic * P, lrs_dat * Q, lrs_dic * P2orig, long order[])
+getabasis2 (lrs_dic * P, lrs_dat * Q, lrs_dic * P2orig, long order[],
+	    Nash2State &state)
 
 /* Pivot Ax<=b to standard form */
 /*Try to find a starting basis by pivoting in the variables x[1]..x[d]        */
@@ -83,16 +135,15 @@ getabasis2 (lrs_dic * P, lrs_dat * Q, lrs_dic * P2orig, long order[])
   long m, d, nlinearity;
   long nredundcol = 0L;		/* will be calculated here */
 
-  static long firsttime=TRUE;
-  static long *linindex;
+  long *&linindex = state.linindex;
 
   m = P->m;
   d = P->d;
   nlinearity = Q->nlinearity;
 
-  if(firsttime)
+  if(state.firsttime)
   {
-    firsttime = FALSE;
+    state.firsttime = FALSE;
     linindex = (long int *) calloc ((m + d + 2), sizeof (long));
   }
   else     /* after first time we update the change in linearities from the last time, saving many pivots */
@@ -276,7 +327,8 @@ hotstart:
 #define D (*D_p)
 
 long 
-lrs_getfirstbasis2 (lrs_dic ** D_p, lrs_dat * Q, lrs_dic * P2orig, lrs_mp_matrix * Lin, long no_output)
+lrs_getfirstbasis2 (lrs_dic ** D_p, lrs_dat * Q, lrs_dic * P2orig, lrs_mp_matrix * Lin, long no_output,
+		    Nash2State &state)
 /* gets first basis, FALSE if none              */
 /* P may get changed if lin. space Lin found    */
 /* no_output is TRUE supresses output headers   */
@@ -292,8 +344,6 @@ lrs_getfirstbasis2 (lrs_dic ** D_p, lrs_dat * Q, lrs_dic * P2orig, lrs_mp_matrix
   long hull = Q->hull;
   long m, d, lastdv, nlinearity, nredundcol;
 
-  static long ocount=0;
-
 
   m = D->m;
   d = D->d;
@@ -351,7 +401,7 @@ lrs_getfirstbasis2 (lrs_dic ** D_p, lrs_dat * Q, lrs_dic * P2orig, lrs_mp_matrix
 /* The inequality array is used to give the insertion order                   */
 /* and is defaulted to the last d rows when givenstart=FALSE                  */
 
-  if (!getabasis2 (D, Q,P2orig, inequality))
+  if (!getabasis2 (D, Q,P2orig, inequality, state))
           return FALSE;
 
   if(Q->debug)
@@ -430,7 +480,6 @@ lrs_getfirstbasis2 (lrs_dic ** D_p, lrs_dat * Q, lrs_dic * P2orig, lrs_mp_matrix
       if (Q->verbose)
       {
       fprintf (lrs_ofp, "\nNumber of pivots for starting dictionary: %ld",Q->count[3]);
-      ocount=Q->count[3];
       }
 
 /* Do dual pivots to get primal feasibility */
@@ -440,7 +489,6 @@ lrs_getfirstbasis2 (lrs_dic ** D_p, lrs_dat * Q, lrs_dic * P2orig, lrs_mp_matrix
       {
           fprintf (lrs_ofp, "\nNumber of pivots for feasible solution: %ld",Q->count[3]);
           fprintf (lrs_ofp, " - No feasible solution");
-          ocount=Q->count[3];
       }
       return FALSE;
     }
@@ -448,7 +496,6 @@ lrs_getfirstbasis2 (lrs_dic ** D_p, lrs_dat * Q, lrs_dic * P2orig, lrs_mp_matrix
     if (Q->verbose)
      {
       fprintf (lrs_ofp, "\nNumber of pivots for feasible solution: %ld",Q->count[3]);
-      ocount=Q->count[3];
      }
 
 
@@ -584,7 +631,8 @@ long nash2_main (lrs_dic *P1, lrs_dat *Q1, lrs_dic *P2orig,
 		 lrs_mp_vector output1, lrs_mp_vector output2,
 		 const Game &p_game,
 		 List<MixedStrategyProfile<Rational> > &p_equilibria,
-		 shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium)
+		 shared_ptr<StrategyProfileRenderer<Rational> > p_onEquilibrium,
+		 Nash2State &state)
 
 
 {
@@ -596,8 +644,6 @@ long nash2_main (lrs_dic *P1, lrs_dat *Q1, lrs_dic *P2orig,
   long prune = FALSE;		/* if TRUE, getnextbasis will prune tree and backtrack  */
   long nlinearity;
   long *linearity;
-  static long firstwarning=TRUE;    /* FALSE if dual deg warning for Q2 already given     */
-  static long firstunbounded=TRUE;  /* FALSE if dual deg warning for Q2 already given     */
 
   long i,j;
 
@@ -634,16 +680,16 @@ long nash2_main (lrs_dic *P1, lrs_dat *Q1, lrs_dic *P2orig,
   //         Lin is created if necessary to hold linearity space
   //         Print linearity space if any, and retrieve output from first
   //         dict.
-  if (!lrs_getfirstbasis2 (&P2, Q2, P2orig, &Lin, TRUE)) {
+  if (!lrs_getfirstbasis2 (&P2, Q2, P2orig, &Lin, TRUE, state)) {
     goto sayonara;
   }
-  if (firstwarning && Q2->dualdeg) {
-    firstwarning=FALSE;
+  if (state.firstwarning && Q2->dualdeg) {
+    state.firstwarning=FALSE;
     printf("\n*Warning! Dual degenerate, ouput may be incomplete");
     printf("\n*Recommendation: Add dualperturb option before maximize in second input file\n");
   }
-  if (firstunbounded && Q2->unbounded) {
-    firstunbounded=FALSE;
+  if (state.firstunbounded && Q2->unbounded) {
+    state.firstunbounded=FALSE;
     printf("\n*Warning! Unbounded starting dictionary for p2, output may be incomplete");
     printf("\n*Recommendation: Change/remove maximize option, or include bounds \n");
   }
@@ -886,8 +932,10 @@ EnumMixedLrsStrategySolver::Solve(const Game &p_game) const
   long prune = FALSE;		/* if TRUE, getnextbasis will prune tree and backtrack  */
 
   List<MixedStrategyProfile<Rational> > equilibria;
+  Nash2State state;
   
   // Step 1: Set up the problem
+  LrsLockGuard guard;
   LrsData data(p_game);
 
   output1 = lrs_alloc_mp_vector(data.Q1->n + data.Q1->m);   /* output holds one line of output from dictionary     */
@@ -951,7 +999,7 @@ EnumMixedLrsStrategySolver::Solve(const Game &p_game) const
     prune = lrs_checkbound(data.P1, data.Q1);
     if (!prune && lrs_getsolution(data.P1, data.Q1, output1, col)) {
       nash2_main(data.P1,data.Q1,P2orig,data.Q2,output1,output2,p_game,
-		 equilibria, m_onEquilibrium);
+		 equilibria, m_onEquilibrium, state);
     }
   } while (lrs_getnextbasis(&data.P1, data.Q1, prune));
 
@@ -0,0 +1,164 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/src/enumpure/enumpure.cc
+// Enumeration of pure-strategy Nash equilibria
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <cmath>
+#include <vector>
+
+#include "gambit/gambit.h"
+#include "gambit/gametable.h"
+#include "gambit/nash/enumpure.h"
+
+namespace Gambit {
+namespace Nash {
+
+namespace {
+
+//
+// Clears the flags of all contingencies in which player pl is not
+// playing a best response.  The contingencies are grouped into fibers,
+// in which all players but pl play fixed strategies; each fiber is
+// examined independently, and fibers are divided among threads.
+// Fibers with no flagged contingencies remaining are skipped.
+//
+// The best responses in a fiber are located using the double-precision
+// payoffs; any strategies which are within rounding of the maximum
+// are then compared using the exact payoffs.
+//
+void MarkBestResponses(const GameTableRep &p_game, int pl,
+		       std::vector<char> &p_flags)
+{
+  const double *payoffs = p_game.GetPayoffTable<double>(pl);
+  const Rational *exact = p_game.GetPayoffTable<Rational>(pl);
+
+  long n = p_game.GetPlayer(pl)->NumStrategies(), stride = 1L;
+  for (int k = 1; k < pl; stride *= p_game.GetPlayer(k++)->NumStrategies());
+  long fibers = (long) p_flags.size() / n;
+
+#pragma omp parallel for schedule(static)
+  for (long fiber = 0; fiber < fibers; fiber++) {
+    long base = (fiber % stride) + (fiber / stride) * stride * n;
+
+    bool live = false;
+    for (long s = 0; s < n && !live; s++) {
+      live = p_flags[base + s * stride];
+    }
+    if (!live) continue;
+
+    double best = payoffs[base];
+    for (long s = 1; s < n; s++) {
+      if (payoffs[base + s * stride] > best) {
+	best = payoffs[base + s * stride];
+      }
+    }
+    double cutoff = best - 1.0e-9 * (1.0 + std::fabs(best));
+
+    long candidates = 0, argmax = 0;
+    for (long s = 0; s < n; s++) {
+      if (payoffs[base + s * stride] >= cutoff) {
+	candidates++;
+	argmax = s;
+      }
+    }
+
+    if (candidates == 1) {
+      for (long s = 0; s < n; s++) {
+	if (s != argmax) p_flags[base + s * stride] = 0;
+      }
+      continue;
+    }
+
+    const Rational *max = 0;
+    for (long s = 0; s < n; s++) {
+      if (payoffs[base + s * stride] >= cutoff &&
+	  (!max || exact[base + s * stride] > *max)) {
+	max = &exact[base + s * stride];
+      }
+    }
+    for (long s = 0; s < n; s++) {
+      if (payoffs[base + s * stride] < cutoff ||
+	  exact[base + s * stride] != *max) {
+	p_flags[base + s * stride] = 0;
+      }
+    }
+  }
+}
+
+}  // end anonymous namespace
+
+List<MixedStrategyProfile<Rational> >
+EnumPureStrategySolver::SolveTable(const Game &p_game) const
+{
+  const GameTableRep &game = dynamic_cast<GameTableRep &>(*p_game);
+
+  // Build the payoff tables before any threads are started.
+  for (int pl = 1; pl <= game.NumPlayers(); pl++) {
+    game.GetPayoffTable<double>(pl);
+    game.GetPayoffTable<Rational>(pl);
+  }
+
+  std::vector<char> flags(game.NumStrategyContingencies(), 1);
+  for (int pl = 1; pl <= game.NumPlayers(); pl++) {
+    MarkBestResponses(game, pl, flags);
+  }
+
+  // Contingencies are numbered with the first player's strategy varying
+  // fastest, which is the order in which StrategyProfileIterator visits them.
+  List<MixedStrategyProfile<Rational> > solutions;
+  for (long cont = 0; cont < (long) flags.size(); cont++) {
+    if (!flags[cont]) continue;
+    MixedStrategyProfile<Rational> profile = p_game->NewMixedStrategyProfile(Rational(0));
+    static_cast<Vector<Rational> &>(profile) = Rational(0);
+    long index = cont;
+    for (int pl = 1; pl <= game.NumPlayers(); pl++) {
+      GamePlayer player = game.GetPlayer(pl);
+      profile[player->GetStrategy(index % player->NumStrategies() + 1)] = Rational(1);
+      index /= player->NumStrategies();
+    }
+    m_onEquilibrium->Render(profile);
+    solutions.Append(profile);
+  }
+  return solutions;
+}
+
+List<MixedStrategyProfile<Rational> >
+EnumPureStrategySolver::Solve(const Game &p_game) const
+{
+  if (!p_game->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+  if (dynamic_cast<GameTableRep *>(p_game.operator->())) {
+    return SolveTable(p_game);
+  }
+
+  List<MixedStrategyProfile<Rational> > solutions;
+  for (StrategyProfileIterator citer(p_game); !citer.AtEnd(); citer++) {
+    if ((*citer)->IsNash()) {
+      MixedStrategyProfile<Rational> profile = (*citer)->ToMixedStrategyProfile();
+      m_onEquilibrium->Render(profile);
+      solutions.Append(profile);
+    }
+  }
+  return solutions;
+}
+
+}  // end namespace Gambit::Nash
+}  // end namespace Gambit
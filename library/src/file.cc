@@ -23,12 +23,21 @@
 #include <cstdlib>
 #include <cctype>
 #include <iostream>
+#include <fstream>
 #include <sstream>
 #include <map>
 
 #include "gambit/gambit.h"
 // for explicit access to turning off canonicalization
 #include "gambit/gametree.h"
+#include "gambit/binfile.h"
+
+#if HAVE_MMAP
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif  // HAVE_MMAP
   
 
 namespace {
@@ -46,22 +55,31 @@ typedef enum {
 //! including the nonsignificance of whitespace and the possibility of
 //! escaped-quotes within text labels.
 //!
+//! The parser works directly on the text of the file held in memory.
+//! Numbers and symbols are scanned in place; their text is copied into
+//! a single buffer whose storage is reused from token to token, so
+//! reading a long list of payoffs does not allocate per token.
+//!
 class GameParserState {
 private:
-  std::istream &m_file;
+  const char *m_current, *m_end;
 
   int m_currentLine;
   int m_currentColumn;
   GameFileToken m_lastToken;
   std::string m_lastText;
 
-  void ReadChar(char& c);
-  void UnreadChar(void);
+  bool AtEnd(void) const { return m_current >= m_end; }
+  char ReadChar(void)
+  { m_currentColumn++;  return (m_current < m_end) ? *m_current++ : '\0'; }
   void IncreaseLine(void);
+  void ReadDigits(void)
+  { while (!AtEnd() && isdigit(*m_current)) ReadChar(); }
 
 public:
-  GameParserState(std::istream &p_file) :
-    m_file(p_file), m_currentLine(1), m_currentColumn(1) { }
+  GameParserState(const char *p_begin, const char *p_end) :
+    m_current(p_begin), m_end(p_end),
+    m_currentLine(1), m_currentColumn(1) { }
 
   GameFileToken GetNextToken(void);
   GameFileToken GetCurrentToken(void) const { return m_lastToken; }
@@ -69,20 +87,10 @@ public:
   int GetCurrentColumn(void) const { return m_currentColumn; }
   std::string CreateLineMsg(const std::string &msg);
   const std::string &GetLastText(void) const { return m_lastText; }
+  /// The text not yet read by the parser
+  const char *GetPosition(void) const { return m_current; }
 };
 
-void GameParserState::ReadChar(char& c)
-{
-  m_file.get(c);
-  m_currentColumn++;
-}
-
-void GameParserState::UnreadChar(void)
-{
-  m_file.unget();
-  m_currentColumn--;
-}
-
 void GameParserState::IncreaseLine(void){
   m_currentLine++;
   // Reset column
@@ -92,16 +100,12 @@ void GameParserState::IncreaseLine(void){
 GameFileToken GameParserState::GetNextToken(void)
 {
   char c = ' ';
-  if (m_file.eof()) {
-    return (m_lastToken = TOKEN_EOF);
-  }
-
   while (isspace(c)) {
-    ReadChar(c);
-    if (!m_file.good()) {
+    if (AtEnd()) {
       return (m_lastToken = TOKEN_EOF);
     }
-    else if (c == '\n') {
+    c = ReadChar();
+    if (c == '\n') {
       IncreaseLine();
     }
   }
@@ -115,152 +119,73 @@ GameFileToken GameParserState::GetNextToken(void)
   else if (c == ',') {
     return (m_lastToken = TOKEN_COMMA);
   }
-  else if (isdigit(c) || c == '-' || c == '+') {
-    std::string buf;
-    buf += c;
-    ReadChar(c);
-
-    while (!m_file.eof() && m_file.good() && isdigit(c)) {
-      buf += c;
-      ReadChar(c);
-    }
-
-    if (m_file.eof() || !m_file.good()) {
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
-    }
-
-    if (c == '.') {
-      buf += c;
-      ReadChar(c);
-      while (isdigit(c)) {
-        buf += c;
-        ReadChar(c);
+  else if (isdigit(c) || c == '-' || c == '+' || c == '.') {
+    const char *start = m_current - 1;
+    if (c != '.') {
+      ReadDigits();
+      if (!AtEnd() && *m_current == '/') {
+	ReadChar();
+	ReadDigits();
       }
-
-      if (c == 'e' || c == 'E') {
-        buf += c;
-        ReadChar(c);
-        if (c == '+' && c == '-' && !isdigit(c)) {
-          throw InvalidFileException(CreateLineMsg("Invalid Token +/-"));
-        }
-        buf += c;
-        ReadChar(c);
-        while (isdigit(c)) {
-          buf += c;
-          ReadChar(c);
-        }
-      }
-
-      UnreadChar();
-      m_lastText = buf;
-
-      return (m_lastToken = TOKEN_NUMBER);
-    }
-    else if (c == '/') {
-      buf += c;
-      ReadChar(c);
-      while (isdigit(c)) {
-        buf += c;
-        ReadChar(c);
-      }
-      UnreadChar();
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
-    }
-    else if (c == 'e' || c == 'E') {
-      buf += c;
-      ReadChar(c);
-      if (c == '+' && c == '-' && !isdigit(c)) {
-        throw InvalidFileException(CreateLineMsg("Invalid Token +/-"));
-      }
-      buf += c;
-      ReadChar(c);
-      while (isdigit(c)) {
-        buf += c;
-        ReadChar(c);
+      else {
+	if (!AtEnd() && *m_current == '.') {
+	  ReadChar();
+	  ReadDigits();
+	}
+	if (!AtEnd() && (*m_current == 'e' || *m_current == 'E')) {
+	  ReadChar();
+	  // The character following the exponent marker is taken as part
+	  // of the number, whether it is a sign or a digit
+	  if (!AtEnd()) {
+	    ReadChar();
+	  }
+	  ReadDigits();
+	}
       }
-      UnreadChar();
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
     }
     else {
-      UnreadChar();
-      m_lastText = buf;
-      return (m_lastToken = TOKEN_NUMBER);
-    }
-  }
-  else if (c == '.') {
-    std::string buf;
-    buf += c;
-    ReadChar(c);
-
-    while (isdigit(c)) {
-      buf += c;
-      ReadChar(c);
+      ReadDigits();
     }
-    UnreadChar();
-    m_lastText = buf;
+    m_lastText.assign(start, m_current - start);
     return (m_lastToken = TOKEN_NUMBER);
   }
-
   else if (c == '"') {
     // We need to do a little magic here, since escaped quotes inside
     // the string are treated as quotes (not end-of-string)
-    UnreadChar();
-    char a;
+    m_lastText.clear();
+    bool lastslash = false;
 
-    m_lastText = "";
-
-    do  {
-      ReadChar(a);
-      if (a == '\n') {
-        IncreaseLine();
+    char a = ReadChar();
+    while  (a != '\"' || lastslash)  {
+      if (AtEnd())  {
+	throw InvalidFileException(CreateLineMsg("End of file encountered when reading string label"));
       }
-    } while (isspace(a));
-
-    if (a == '\"')  {
-      bool lastslash = false;
-
-      ReadChar(a);
-      while  (a != '\"' || lastslash)  {
-	if (m_file.eof() || !m_file.good())  {
-	  throw InvalidFileException(CreateLineMsg("End of file encountered when reading string label"));
-	}
-        if (lastslash && a == '"') {
-          m_lastText += '"';
-	}
-        else if (lastslash)  {
-          m_lastText += '\\';
-          m_lastText += a;
-        }
-        else if (a != '\\')
-          m_lastText += a;
-
-        lastslash = (a == '\\');
-        ReadChar(a);
+      if (lastslash && a == '"') {
+	m_lastText += '"';
       }
-    }
-    else  {
-      do  {
-      	m_lastText += a;
-        ReadChar(a);
-	if (m_file.eof() || !m_file.good())  {
-	  throw InvalidFileException(CreateLineMsg("End of file encountered when reading string label"));
-	}
-        if (a == '\n') {
-          IncreaseLine();
-        }
-      }  while (!isspace(a));
+      else if (lastslash)  {
+	m_lastText += '\\';
+	m_lastText += a;
+      }
+      else if (a != '\\')
+	m_lastText += a;
+
+      lastslash = (a == '\\');
+      a = ReadChar();
     }
 
     return (m_lastToken = TOKEN_TEXT);
   }
 
-  m_lastText = "";
-  while (!isspace(c) && !m_file.eof()) {
-    m_lastText += c;
-    ReadChar(c);
+  // A symbol extends to the next whitespace character, which is
+  // also consumed.
+  const char *start = m_current - 1;
+  while (!AtEnd() && !isspace(*m_current)) {
+    ReadChar();
+  }
+  m_lastText.assign(start, m_current - start);
+  if (!AtEnd() && ReadChar() == '\n') {
+    IncreaseLine();
   }
   return (m_lastToken = TOKEN_SYMBOL);
 }
@@ -605,19 +530,30 @@ void ParseOutcomeBody(GameParserState &p_parser, GameRep *p_nfg)
 
 void ParsePayoffBody(GameParserState &p_parser, GameRep *p_nfg)
 {
-  StrategyProfileIterator iter(StrategySupportProfile(static_cast<GameRep *>(p_nfg)));
-  int pl = 1;
+  // The payoffs are listed contingency by contingency, in the order in
+  // which contingencies are numbered; in a newly-created table each
+  // contingency has its own outcome with the same number, so the payoffs
+  // are stored into the outcomes directly as they are scanned.
+  int numPlayers = p_nfg->NumPlayers();
+  int numContingencies = p_nfg->NumOutcomes();
+  int cont = 1, pl = 1;
+  GameOutcome outcome = p_nfg->GetOutcome(cont);
 
   while (p_parser.GetCurrentToken() != TOKEN_EOF) {
-    if (p_parser.GetCurrentToken() == TOKEN_NUMBER) {
-      (*iter)->GetOutcome()->SetPayoff(pl, p_parser.GetLastText());
-    }
-    else {
+    if (p_parser.GetCurrentToken() != TOKEN_NUMBER) {
       throw InvalidFileException(p_parser.CreateLineMsg("Expecting payoff"));
     }
+    if (cont > numContingencies) {
+      throw InvalidFileException(
+	p_parser.CreateLineMsg("More payoffs than contingencies"));
+    }
+
+    outcome->SetPayoff(pl, p_parser.GetLastText());
 
-    if (++pl > p_nfg->NumPlayers()) {
-      iter++;
+    if (++pl > numPlayers) {
+      if (++cont <= numContingencies) {
+	outcome = p_nfg->GetOutcome(cont);
+      }
       pl = 1;
     }
     p_parser.GetNextToken();
@@ -1048,22 +984,37 @@ Game GameXMLSavefile::GetGame(void) const
 }
 
 //=========================================================================
-//    ReadGame: Global visible function to read an .efg or .nfg file
+//   ReadGame: Global visible functions to read an .efg or .nfg file
 //=========================================================================
 
-Game ReadGame(std::istream &p_file) throw (InvalidFileException)
+namespace {
+
+/// Reads a game from the savefile held in the range [p_begin, p_end)
+Game ParseGame(const char *p_begin, const char *p_end)
 {
-  std::stringstream buffer;
-  buffer << p_file.rdbuf();
-  try {
-    GameXMLSavefile doc(buffer.str());
-    return doc.GetGame();
+  if (IsBinaryGameFile(p_begin, p_end)) {
+    try {
+      return ReadBinaryGame(p_begin, p_end);
+    }
+    catch (InvalidFileException &) {
+      throw;
+    }
+    catch (std::exception &ex) {
+      throw InvalidFileException(ex.what());
+    }
   }
-  catch (InvalidFileException) {
-    buffer.seekg(0, std::ios::beg);
+
+  const char *start = p_begin;
+  while (start != p_end && isspace(*start))  start++;
+  if (start != p_end && *start == '<') {
+    try {
+      GameXMLSavefile doc(std::string(p_begin, p_end));
+      return doc.GetGame();
+    }
+    catch (InvalidFileException) { }
   }
 
-  GameParserState parser(buffer);
+  GameParserState parser(p_begin, p_end);
   try {
     if (parser.GetNextToken() != TOKEN_SYMBOL) {
       throw InvalidFileException(parser.CreateLineMsg("Expecting file type"));
@@ -1083,10 +1034,12 @@ Game ReadGame(std::istream &p_file) throw (InvalidFileException)
       return game;
     }
     else if (parser.GetLastText() == "#AGG") {
-      return GameAggRep::ReadAggFile(buffer);
+      std::istringstream rest(std::string(parser.GetPosition(), p_end));
+      return GameAggRep::ReadAggFile(rest);
     }
     else if (parser.GetLastText() == "#BAGG") {
-      return GameBagentRep::ReadBaggFile(buffer);
+      std::istringstream rest(std::string(parser.GetPosition(), p_end));
+      return GameBagentRep::ReadBaggFile(rest);
     }
     else {
       throw InvalidFileException("Tokens 'EFG' or 'NFG' or '#AGG' or '#BAGG' expected at start of file");
@@ -1097,4 +1050,60 @@ Game ReadGame(std::istream &p_file) throw (InvalidFileException)
   }
 }
 
+} // end anonymous namespace
+
+Game ReadGame(std::istream &p_file) throw (InvalidFileException)
+{
+  // Read the whole file into memory in large blocks; the parsers then
+  // work on it in place.
+  std::string buffer;
+  char block[65536];
+  while (p_file.read(block, sizeof(block)) || p_file.gcount() > 0) {
+    buffer.append(block, p_file.gcount());
+  }
+  return ParseGame(buffer.data(), buffer.data() + buffer.size());
+}
+
+Game ReadGameFile(const std::string &p_filename) throw (InvalidFileException)
+{
+#if HAVE_MMAP
+  int fd = open(p_filename.c_str(), O_RDONLY);
+  if (fd < 0) {
+    throw InvalidFileException("Unable to open file '" + p_filename + "'");
+  }
+  struct stat info;
+  if (fstat(fd, &info) < 0 || !S_ISREG(info.st_mode)) {
+    close(fd);
+    // Not something which can be mapped; read it as a stream instead
+    std::ifstream file(p_filename.c_str(), std::ios::binary);
+    return ReadGame(file);
+  }
+  if (info.st_size == 0) {
+    close(fd);
+    return ParseGame(0, 0);
+  }
+  void *data = mmap(0, info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED) {
+    throw InvalidFileException("Unable to read file '" + p_filename + "'");
+  }
+  try {
+    Game game = ParseGame(static_cast<const char *>(data),
+			  static_cast<const char *>(data) + info.st_size);
+    munmap(data, info.st_size);
+    return game;
+  }
+  catch (...) {
+    munmap(data, info.st_size);
+    throw;
+  }
+#else
+  std::ifstream file(p_filename.c_str(), std::ios::binary);
+  if (!file.is_open()) {
+    throw InvalidFileException("Unable to open file '" + p_filename + "'");
+  }
+  return ReadGame(file);
+#endif  // HAVE_MMAP
+}
+
 } // end namespace Gambit
@@ -26,6 +26,7 @@
 #include "gambit/gambit.h"
 #include "gambit/gametree.h"
 #include "gambit/gametable.h"
+#include "gambit/binfile.h"
 
 namespace Gambit {
 
@@ -52,7 +53,7 @@ void GameStrategyRep::DeleteStrategy(void)
   for (int st = 1; st <= m_player->m_strategies.Length(); st++) {
     m_player->m_strategies[st]->m_number = st;
   }
-  //m_player->m_game->RebuildTable();
+  dynamic_cast<GameTableRep *>(m_player->m_game)->RebuildTable();
   this->Invalidate();
 }
 
@@ -313,41 +314,49 @@ GameAction PureBehaviorProfile::GetAction(const GameInfoset &infoset) const
 
 void PureBehaviorProfile::SetAction(const GameAction &action)
 {
-  m_profile[action->GetInfoset()->GetPlayer()->GetNumber()]
-    [action->GetInfoset()->GetNumber()] = action;
+  GameObjectRef<GameInfosetRep> infoset = action->GetInfoset();
+  m_profile[infoset->GetPlayer()->GetNumber()][infoset->GetNumber()] = action;
 }
 
-template <class T> 
-T PureBehaviorProfile::GetPayoff(const GameNode &p_node,
-				 int pl) const
+template <class T>
+T PureBehaviorProfile::GetPayoff(const CompiledGameTree &p_tree,
+				 int p_node, int pl) const
 {
   T payoff(0);
 
-  GameTreeNodeRep *node = dynamic_cast<GameTreeNodeRep *>(p_node.operator->());
-
-  if (node->outcome) {
-    payoff += node->outcome->GetPayoff<T>(pl);
+  if (p_tree.HasOutcome(p_node)) {
+    payoff += p_tree.GetPayoff<T>(p_node, pl);
   }
 
-  if (!node->IsTerminal()) {
-    if (node->GetInfoset()->IsChanceInfoset()) {
-      for (int i = 1; i <= node->NumChildren(); i++) {
-	GameTreeInfosetRep *infoset = node->infoset;
-	payoff += (infoset->GetActionProb(i, (T) 0) *
-		   GetPayoff<T>(node->children[i], pl));
+  int infoset = p_tree.GetInfoset(p_node);
+  if (infoset >= 0) {
+    int player = p_tree.GetPlayer(infoset);
+    if (player == 0) {
+      for (int i = 1; i <= p_tree.NumChildren(p_node); i++) {
+	payoff += (p_tree.GetActionProb<T>(infoset, i) *
+		   GetPayoff<T>(p_tree, p_tree.GetChild(p_node, i), pl));
       }
     }
     else {
-      int player = node->GetPlayer()->GetNumber();
-      int iset = node->GetInfoset()->GetNumber();
-      payoff += GetPayoff<T>(node->children[m_profile[player][iset]->GetNumber()], 
-				pl);
+      int iset = p_tree.GetNumber(infoset);
+      payoff += GetPayoff<T>(p_tree,
+			     p_tree.GetChild(p_node, m_profile[player][iset]->GetNumber()),
+			     pl);
     }
   }
 
   return payoff;
 }
 
+template <class T> 
+T PureBehaviorProfile::GetPayoff(const GameNode &p_node,
+				 int pl) const
+{
+  const CompiledGameTree &tree =
+    dynamic_cast<GameTreeRep &>(*m_efg).GetCompiledTree();
+  return GetPayoff<T>(tree, p_node->GetNumber() - 1, pl);
+}
+
 // Explicit instantiations
 template double PureBehaviorProfile::GetPayoff(const GameNode &, int pl) const;
 template Rational PureBehaviorProfile::GetPayoff(const GameNode &, int pl) const;
@@ -400,6 +409,20 @@ PureBehaviorProfile::ToMixedBehaviorProfile(void) const
 //                            class GameRep
 //========================================================================
 
+//------------------------------------------------------------------------
+//                     GameRep: General data access
+//------------------------------------------------------------------------
+
+Array<int> GameRep::GetPlayerClasses(void) const
+{
+  // In general no symmetry is known, and each player is a class of its own
+  Array<int> classes(NumPlayers());
+  for (int pl = 1; pl <= classes.Length(); pl++) {
+    classes[pl] = pl;
+  }
+  return classes;
+}
+
 //------------------------------------------------------------------------
 //                     GameRep: Writing data files
 //------------------------------------------------------------------------
@@ -587,6 +610,27 @@ GameOutcome GameExplicitRep::NewOutcome(void)
   return m_outcomes[m_outcomes.Last()];
 }
 
+//------------------------------------------------------------------------
+//                   GameExplicitRep: Copying games
+//------------------------------------------------------------------------
+
+void GameExplicitRep::CopyCommonData(GameExplicitRep *p_copy) const
+{
+  p_copy->m_title = m_title;
+  p_copy->m_comment = m_comment;
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    p_copy->m_players[pl]->m_label = m_players[pl]->m_label;
+  }
+
+  p_copy->m_outcomes = Array<GameOutcomeRep *>(m_outcomes.Length());
+  for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+    GameOutcomeRep *outcome = new GameOutcomeRep(p_copy, outc);
+    outcome->m_label = m_outcomes[outc]->m_label;
+    outcome->m_payoffs = m_outcomes[outc]->m_payoffs;
+    p_copy->m_outcomes[outc] = outcome;
+  }
+}
+
 //------------------------------------------------------------------------
 //                GameExplicitRep: Writing data files
 //------------------------------------------------------------------------
@@ -602,11 +646,47 @@ void GameExplicitRep::Write(std::ostream &p_stream,
 	   (p_format == "native" && !IsTree())) {
     WriteNfgFile(p_stream);
   }
+  else if (p_format == "binary") {
+    WriteBinaryFile(p_stream);
+  }
   else {
     throw UndefinedException();
   }
 }
 
+void GameExplicitRep::WriteBinaryOutcomes(BinaryFileWriter &p_file) const
+{
+  p_file.WriteCount(m_outcomes.Length());
+  for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+    p_file.WriteString(m_outcomes[outc]->m_label);
+    for (int pl = 1; pl <= m_players.Length(); pl++) {
+      p_file.WriteNumber(m_outcomes[outc]->m_payoffs[pl]);
+    }
+  }
+}
+
+void GameExplicitRep::ReadBinaryOutcomes(BinaryFileReader &p_file)
+{
+  // Each outcome takes at least one word, which bounds the count
+  unsigned int numOutcomes = p_file.ReadCount(p_file.Remaining() / 4);
+  int first = m_outcomes.Length();
+  Array<GameOutcomeRep *> outcomes(first + numOutcomes);
+  for (int outc = 1; outc <= first; outc++) {
+    outcomes[outc] = m_outcomes[outc];
+  }
+  for (unsigned int outc = 1; outc <= numOutcomes; outc++) {
+    outcomes[first + outc] = new GameOutcomeRep(this, first + outc);
+  }
+  m_outcomes = outcomes;
+  for (unsigned int outc = 1; outc <= numOutcomes; outc++) {
+    GameOutcomeRep *outcome = m_outcomes[first + outc];
+    outcome->m_label = p_file.ReadString();
+    for (int pl = 1; pl <= m_players.Length(); pl++) {
+      outcome->m_payoffs[pl] = p_file.ReadNumber();
+    }
+  }
+}
+
 
 
   
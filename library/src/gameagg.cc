@@ -101,10 +101,18 @@ GameAggRep::GameAggRep(agg::AGG *p_aggPtr)
 
 Game GameAggRep::Copy(void) const
 {
-  std::ostringstream os;
-  WriteAggFile(os);
-  std::istringstream is(os.str());
-  return ReadAggFile(is);
+  GameAggRep *copy = new GameAggRep(new agg::AGG(*aggPtr));
+  Game game = copy;
+  copy->m_title = m_title;
+  copy->m_comment = m_comment;
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    copy->m_players[pl]->m_label = m_players[pl]->m_label;
+    for (int st = 1; st <= m_players[pl]->m_strategies.Length(); st++) {
+      copy->m_players[pl]->m_strategies[st]->m_label =
+	m_players[pl]->m_strategies[st]->m_label;
+    }
+  }
+  return game;
 }
 
 //------------------------------------------------------------------------
@@ -188,6 +196,28 @@ bool GameAggRep::IsConstSum(void) const
   return true;
 }
 
+Array<int> GameAggRep::GetPlayerClasses(void) const
+{
+  // Players with the same action set are interchangeable.  The player
+  // classes of the AGG are formed from the sorted action sets, so they are
+  // refined here to keep the strategies of class members in correspondence.
+  Array<int> classes(m_players.Length());
+  int numClasses = 0;
+  for (int pl = 1; pl <= classes.Length(); pl++) {
+    classes[pl] = 0;
+    for (int other = 1; other < pl; other++) {
+      if (aggPtr->getActionSet(pl - 1) == aggPtr->getActionSet(other - 1)) {
+	classes[pl] = classes[other];
+	break;
+      }
+    }
+    if (classes[pl] == 0) {
+      classes[pl] = ++numClasses;
+    }
+  }
+  return classes;
+}
+
 //------------------------------------------------------------------------
 //                   GameAggRep: Writing data files
 //------------------------------------------------------------------------
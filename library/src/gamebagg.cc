@@ -111,10 +111,18 @@ GameBagentRep::GameBagentRep(agg::BAGG *_baggPtr)
 
 Game GameBagentRep::Copy(void) const
 {
-  std::ostringstream os;
-  WriteBaggFile(os);
-  std::istringstream is(os.str());
-  return ReadBaggFile(is);
+  GameBagentRep *copy = new GameBagentRep(new agg::BAGG(*baggPtr));
+  Game game = copy;
+  copy->m_title = m_title;
+  copy->m_comment = m_comment;
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    copy->m_players[pl]->m_label = m_players[pl]->m_label;
+    for (int st = 1; st <= m_players[pl]->m_strategies.Length(); st++) {
+      copy->m_players[pl]->m_strategies[st]->m_label =
+	m_players[pl]->m_strategies[st]->m_label;
+    }
+  }
+  return game;
 }
 
 //------------------------------------------------------------------------
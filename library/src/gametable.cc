@@ -25,6 +25,7 @@
 
 #include "gambit/gambit.h"
 #include "gambit/gametable.h"
+#include "gambit/binfile.h"
 
 namespace Gambit {
 
@@ -87,7 +88,9 @@ GameOutcome TablePureStrategyProfileRep::GetOutcome(void) const
 
 void TablePureStrategyProfileRep::SetOutcome(GameOutcome p_outcome)
 {
-  dynamic_cast<GameTableRep &>(*m_nfg).m_results[m_index] = p_outcome; 
+  GameTableRep &nfg = dynamic_cast<GameTableRep &>(*m_nfg);
+  nfg.m_results[m_index] = p_outcome; 
+  nfg.ClearPayoffCache();
 }
 
 Rational TablePureStrategyProfileRep::GetPayoff(int pl) const
@@ -140,6 +143,7 @@ int Product(const Array<int> &dim)
   
 GameTableRep::GameTableRep(const Array<int> &dim, 
 			   bool p_sparseOutcomes /* = false */)
+  : m_doublePayoffsValid(false), m_rationalPayoffsValid(false)
 {
   m_results = Array<GameOutcomeRep *>(Product(dim));
   for (int pl = 1; pl <= dim.Length(); pl++)  {
@@ -166,10 +170,24 @@ GameTableRep::GameTableRep(const Array<int> &dim,
 
 Game GameTableRep::Copy(void) const
 {
-  std::ostringstream os;
-  WriteNfgFile(os);
-  std::istringstream is(os.str());
-  return ReadGame(is);
+  Array<int> dim(m_players.Length());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    dim[pl] = m_players[pl]->m_strategies.Length();
+  }
+  GameTableRep *nfg = new GameTableRep(dim, true);
+  Game game = nfg;
+  CopyCommonData(nfg);
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    for (int st = 1; st <= dim[pl]; st++) {
+      nfg->m_players[pl]->m_strategies[st]->m_label =
+	m_players[pl]->m_strategies[st]->m_label;
+    }
+  }
+  for (int cont = 1; cont <= m_results.Length(); cont++) {
+    nfg->m_results[cont] = 
+      (m_results[cont]) ? nfg->m_outcomes[m_results[cont]->m_number] : 0;
+  }
+  return game;
 }
 
 //------------------------------------------------------------------------
@@ -200,6 +218,80 @@ bool GameTableRep::IsConstSum(void) const
   return true;
 }
 
+namespace {
+
+//
+// Returns true if exchanging players i and j, who have the same number
+// of strategies, leaves the payoffs of the table game unchanged.
+// The contingency with player i choosing strategy a and player j strategy b
+// is compared with that with i choosing b and j choosing a; each index is
+// the sum of the strategies' offsets, as in GameTableRep::IndexStrategies.
+//
+bool IsTransposition(const GameTableRep &p_game, int i, int j)
+{
+  long ncont = p_game.NumStrategyContingencies();
+  long stride_i = 1, stride_j = 1;
+  for (int pl = 1; pl < i; pl++) {
+    stride_i *= p_game.GetPlayer(pl)->NumStrategies();
+  }
+  for (int pl = 1; pl < j; pl++) {
+    stride_j *= p_game.GetPlayer(pl)->NumStrategies();
+  }
+  long numStrats = p_game.GetPlayer(i)->NumStrategies();
+
+  Array<const Rational *> payoffs(p_game.NumPlayers());
+  for (int pl = 1; pl <= p_game.NumPlayers(); pl++) {
+    payoffs[pl] = p_game.GetPayoffTable<Rational>(pl);
+  }
+
+  for (long cont = 0; cont < ncont; cont++) {
+    long a = (cont / stride_i) % numStrats, b = (cont / stride_j) % numStrats;
+    long swapped = cont + (b - a) * stride_i + (a - b) * stride_j;
+    // Each unordered pair of contingencies need only be checked once
+    if (swapped < cont) continue;
+    if (payoffs[i][cont] != payoffs[j][swapped] ||
+	payoffs[j][cont] != payoffs[i][swapped]) {
+      return false;
+    }
+    for (int pl = 1; pl <= p_game.NumPlayers(); pl++) {
+      if (pl != i && pl != j && payoffs[pl][cont] != payoffs[pl][swapped]) {
+	return false;
+      }
+    }
+  }
+  return true;
+}
+
+}  // end anonymous namespace
+
+//
+// Each player is compared with the first member of each class found so
+// far.  Since the transpositions of a class with its first member generate
+// all permutations of the class, this finds the classes of interchangeable
+// players in which strategies correspond by number.
+//
+Array<int> GameTableRep::GetPlayerClasses(void) const
+{
+  Array<int> classes(m_players.Length());
+  Array<int> firstMembers;
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    classes[pl] = 0;
+    for (int cls = 1; cls <= firstMembers.Length(); cls++) {
+      int first = firstMembers[cls];
+      if (m_players[first]->NumStrategies() == m_players[pl]->NumStrategies() &&
+	  IsTransposition(*this, first, pl)) {
+	classes[pl] = cls;
+	break;
+      }
+    }
+    if (classes[pl] == 0) {
+      firstMembers.Append(pl);
+      classes[pl] = firstMembers.Length();
+    }
+  }
+  return classes;
+}
+
 //------------------------------------------------------------------------
 //                   GameTableRep: Writing data files
 //------------------------------------------------------------------------
@@ -284,6 +376,71 @@ void GameTableRep::WriteNfgFile(std::ostream &p_file) const
   p_file << '\n';
 }
 
+///
+/// Write the game to a binary savefile.  The body consists of the
+/// title and comment; the label, number of strategies, and strategy
+/// labels of each player; the outcomes; and the number of the outcome
+/// (zero for none) at each contingency, in the order of contingency
+/// indices.
+///
+void GameTableRep::WriteBinaryFile(std::ostream &p_file) const
+{
+  BinaryFileWriter writer(BINARY_GAME_TABLE);
+  writer.WriteString(GetTitle());
+  writer.WriteString(m_comment);
+  writer.WriteCount(m_players.Length());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    GamePlayerRep *player = m_players[pl];
+    writer.WriteString(player->m_label);
+    writer.WriteCount(player->m_strategies.Length());
+    for (int st = 1; st <= player->m_strategies.Length(); st++) {
+      writer.WriteString(player->m_strategies[st]->GetLabel());
+    }
+  }
+  WriteBinaryOutcomes(writer);
+  for (int cont = 1; cont <= m_results.Length(); cont++) {
+    writer.WriteCount((m_results[cont]) ? m_results[cont]->m_number : 0);
+  }
+  writer.Flush(p_file);
+}
+
+Game GameTableRep::ReadBinaryFile(BinaryFileReader &p_file)
+{
+  std::string title = p_file.ReadString();
+  std::string comment = p_file.ReadString();
+  Array<int> dim(p_file.ReadCount());
+  Array<Array<std::string> > labels(dim.Length());
+  for (int pl = 1; pl <= dim.Length(); pl++) {
+    labels[pl].Append(p_file.ReadString());
+    dim[pl] = p_file.ReadCount();
+    if (dim[pl] <= 0) {
+      throw InvalidFileException("Player with no strategies in binary savefile");
+    }
+    for (int st = 1; st <= dim[pl]; st++) {
+      labels[pl].Append(p_file.ReadString());
+    }
+  }
+
+  GameTableRep *nfg = new GameTableRep(dim, true);
+  Game game = nfg;
+  nfg->SetTitle(title);
+  nfg->SetComment(comment);
+  for (int pl = 1; pl <= dim.Length(); pl++) {
+    GamePlayerRep *player = nfg->m_players[pl];
+    player->m_label = labels[pl][1];
+    for (int st = 1; st <= dim[pl]; st++) {
+      player->m_strategies[st]->SetLabel(labels[pl][st + 1]);
+    }
+  }
+
+  nfg->ReadBinaryOutcomes(p_file);
+  for (int cont = 1; cont <= nfg->m_results.Length(); cont++) {
+    int outc = p_file.ReadCount(nfg->m_outcomes.Length());
+    nfg->m_results[cont] = (outc > 0) ? nfg->m_outcomes[outc] : 0;
+  }
+  return game;
+}
+
 //------------------------------------------------------------------------
 //                       GameTableRep: Players
 //------------------------------------------------------------------------
@@ -296,6 +453,7 @@ GamePlayer GameTableRep::NewPlayer(void)
   for (int outc = 1; outc <= m_outcomes.Last(); outc++) {
     m_outcomes[outc]->m_payoffs.Append(Number());
   }
+  ClearPayoffCache();
   ClearComputedValues();
   return player;
 }
@@ -315,9 +473,46 @@ void GameTableRep::DeleteOutcome(const GameOutcome &p_outcome)
   for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
     m_outcomes[outc]->m_number = outc;
   }
+  ClearPayoffCache();
   ClearComputedValues();
 }
 
+//------------------------------------------------------------------------
+//                   GameTableRep: Dense payoff tables
+//------------------------------------------------------------------------
+
+template <class T>
+void GameTableRep::BuildPayoffTable(std::vector<T> &p_table) const
+{
+  long ncont = m_results.Length();
+  p_table.assign(ncont * m_players.Length(), T(0));
+  for (long cont = 1; cont <= ncont; cont++) {
+    GameOutcomeRep *outcome = m_results[cont];
+    if (!outcome) continue;
+    for (int pl = 1; pl <= m_players.Length(); pl++) {
+      p_table[(pl - 1) * ncont + cont - 1] = outcome->GetPayoff<T>(pl);
+    }
+  }
+}
+
+template<> const double *GameTableRep::GetPayoffTable(int pl) const
+{
+  if (!m_doublePayoffsValid) {
+    BuildPayoffTable(m_doublePayoffs);
+    m_doublePayoffsValid = true;
+  }
+  return &m_doublePayoffs[(pl - 1) * m_results.Length()];
+}
+
+template<> const Rational *GameTableRep::GetPayoffTable(int pl) const
+{
+  if (!m_rationalPayoffsValid) {
+    BuildPayoffTable(m_rationalPayoffs);
+    m_rationalPayoffsValid = true;
+  }
+  return &m_rationalPayoffs[(pl - 1) * m_results.Length()];
+}
+
 //------------------------------------------------------------------------
 //                   GameTableRep: Factory functions
 //------------------------------------------------------------------------
@@ -382,6 +577,7 @@ void GameTableRep::RebuildTable(void)
   m_results = newResults;
 
   IndexStrategies();
+  ClearPayoffCache();
 }
 
 void GameTableRep::IndexStrategies(void)
@@ -22,9 +22,12 @@
 
 #include <iostream>
 #include <sstream>
+#include <set>
+#include <map>
 
 #include "gambit/gambit.h"
 #include "gambit/gametree.h"
+#include "gambit/binfile.h"
 
 namespace Gambit {
 
@@ -268,14 +271,8 @@ GameAction GameTreeNodeRep::GetPriorAction(void) const
     return 0;
   }
   
-  GameTreeInfosetRep *infoset = m_parent->infoset;
-  for (int i = 1; i <= infoset->NumActions(); i++) {
-    if (GameNode(const_cast<GameTreeNodeRep *>(this)) == GetParent()->GetChild(i)) {
-      return infoset->GetAction(i);
-    }
-  }
-
-  return 0;
+  int i = m_parent->children.Find(const_cast<GameTreeNodeRep *>(this));
+  return (i) ? m_parent->infoset->m_actions[i] : 0;
 }
 
 void GameTreeNodeRep::DeleteOutcome(GameOutcomeRep *outc)
@@ -550,7 +547,7 @@ GameInfoset GameTreeNodeRep::InsertMove(GameInfoset p_infoset)
 //------------------------------------------------------------------------
 
 GameTreeRep::GameTreeRep(void)
-  : m_computedValues(false), m_doCanon(true)
+  : m_computedValues(false), m_doCanon(true), m_compiledValid(false)
 {
   m_chance = new GamePlayerRep(this, 0);
   m_root = new GameTreeNodeRep(this, 0);
@@ -564,10 +561,56 @@ GameTreeRep::~GameTreeRep()
 
 Game GameTreeRep::Copy(void) const
 {
-  std::ostringstream os;
-  WriteEfgFile(os);
-  std::istringstream is(os.str());
-  return ReadGame(is);
+  GameTreeRep *efg = new GameTreeRep;
+  Game game = efg;
+  efg->SetCanonicalization(false);
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    efg->NewPlayer();
+  }
+  CopyCommonData(efg);
+
+  // Copy the nodes in preorder, creating the information sets of the
+  // copy as their first members are reached.
+  std::map<GameTreeInfosetRep *, GameInfoset> infosets;
+  List<GameTreeNodeRep *> sources, copies;
+  sources.Append(m_root);
+  copies.Append(efg->m_root);
+  while (sources.Length() > 0) {
+    GameTreeNodeRep *src = sources.Remove(sources.Length());
+    GameTreeNodeRep *dest = copies.Remove(copies.Length());
+    dest->m_label = src->m_label;
+    if (src->outcome) {
+      dest->outcome = efg->m_outcomes[src->outcome->m_number];
+    }
+    if (src->infoset) {
+      std::map<GameTreeInfosetRep *, GameInfoset>::const_iterator it =
+	infosets.find(src->infoset);
+      if (it != infosets.end()) {
+	dest->AppendMove(it->second);
+      }
+      else {
+	GamePlayerRep *player = (src->infoset->m_player == m_chance) ?
+	  efg->m_chance : efg->m_players[src->infoset->m_player->m_number];
+	GameTreeInfosetRep *infoset =
+	  dynamic_cast<GameTreeInfosetRep *>(dest->AppendMove(player, src->infoset->m_actions.Length()).operator->());
+	infosets[src->infoset] = infoset;
+	infoset->m_label = src->infoset->m_label;
+	for (int act = 1; act <= infoset->m_actions.Length(); act++) {
+	  infoset->m_actions[act]->m_label = src->infoset->m_actions[act]->m_label;
+	}
+	if (player == efg->m_chance) {
+	  infoset->m_probs = src->infoset->m_probs;
+	}
+      }
+      for (int i = src->children.Length(); i >= 1; i--) {
+	sources.Append(src->children[i]);
+	copies.Append(dest->children[i]);
+      }
+    }
+  }
+
+  efg->SetCanonicalization(true);
+  return game;
 }
 
 Game NewTree(void)  { return new GameTreeRep(); }
@@ -742,6 +785,7 @@ void GameTreeRep::ClearComputedValues(void) const
   }
 
   m_computedValues = false;
+  m_compiledValid = false;
 }
 
 void GameTreeRep::BuildComputedValues(void)
@@ -749,6 +793,9 @@ void GameTreeRep::BuildComputedValues(void)
   if (m_computedValues) return;
 
   Canonicalize();
+  if (!m_compiledValid) {
+    CompileTree();
+  }
 
   for (int pl = 1; pl <= m_players.Length(); pl++) {
     m_players[pl]->MakeReducedStrats(m_root, 0);
@@ -762,6 +809,118 @@ void GameTreeRep::BuildComputedValues(void)
   m_computedValues = true;
 }
 
+void GameTreeRep::CompileTree(void) const
+{
+  CompiledGameTree &tree = m_compiled;
+  int numPlayers = m_players.Length();
+  tree.m_numPlayers = numPlayers;
+
+  // Personal information sets first, in order of player and number,
+  // then those of chance
+  std::map<GameTreeInfosetRep *, int> index;
+  tree.m_playerOffset.clear();
+  tree.m_player.clear();
+  tree.m_number.clear();
+  tree.m_actionStart.assign(1, 0);
+  tree.m_memberStart.assign(1, 0);
+  tree.m_members.clear();
+  tree.m_doubleProbs.clear();
+  tree.m_rationalProbs.clear();
+  for (int i = 1; i <= numPlayers + 1; i++) {
+    GamePlayerRep *player = (i <= numPlayers) ? m_players[i] : m_chance;
+    if (i <= numPlayers) {
+      tree.m_playerOffset.push_back(tree.m_player.size());
+    }
+    else {
+      tree.m_chanceOffset = tree.m_player.size();
+    }
+    for (int iset = 1; iset <= player->m_infosets.Length(); iset++) {
+      GameTreeInfosetRep *infoset = player->m_infosets[iset];
+      index[infoset] = tree.m_player.size();
+      tree.m_player.push_back(player->m_number);
+      tree.m_number.push_back(infoset->m_number);
+      for (int act = 1; act <= infoset->m_actions.Length(); act++) {
+	if (player == m_chance) {
+	  tree.m_doubleProbs.push_back(infoset->m_probs[act]);
+	  tree.m_rationalProbs.push_back(infoset->m_probs[act]);
+	}
+	else {
+	  tree.m_doubleProbs.push_back(0.0);
+	  tree.m_rationalProbs.push_back(Rational(0));
+	}
+      }
+      tree.m_actionStart.push_back(tree.m_doubleProbs.size());
+      // The indices of the members are filled in once the nodes have
+      // been visited
+      tree.m_memberStart.push_back(tree.m_memberStart.back() +
+				   infoset->m_members.Length());
+    }
+  }
+
+  tree.m_doublePayoffs.assign(m_outcomes.Length() * numPlayers, 0.0);
+  tree.m_rationalPayoffs.assign(m_outcomes.Length() * numPlayers, Rational(0));
+  for (int outc = 1; outc <= m_outcomes.Length(); outc++) {
+    for (int pl = 1; pl <= numPlayers; pl++) {
+      tree.m_doublePayoffs[(outc - 1) * numPlayers + pl - 1] =
+	m_outcomes[outc]->GetPayoff<double>(pl);
+      tree.m_rationalPayoffs[(outc - 1) * numPlayers + pl - 1] =
+	m_outcomes[outc]->GetPayoff<Rational>(pl);
+    }
+  }
+
+  // Visit the nodes in depth-first order, assigning indices as they
+  // are first reached
+  std::vector<GameTreeNodeRep *> nodes;
+  std::map<GameTreeNodeRep *, int> nodeIndex;
+  tree.m_parent.clear();
+  tree.m_priorAction.clear();
+  tree.m_infoset.clear();
+  tree.m_outcome.clear();
+  std::vector<std::pair<GameTreeNodeRep *, int> > stack;
+  stack.push_back(std::pair<GameTreeNodeRep *, int>(m_root, 0));
+  while (!stack.empty()) {
+    GameTreeNodeRep *node = stack.back().first;
+    int action = stack.back().second;
+    stack.pop_back();
+    nodeIndex[node] = nodes.size();
+    nodes.push_back(node);
+    tree.m_parent.push_back((node->m_parent) ? nodeIndex[node->m_parent] : -1);
+    tree.m_priorAction.push_back(action);
+    tree.m_infoset.push_back((node->infoset) ? index[node->infoset] : -1);
+    tree.m_outcome.push_back((node->outcome) ? node->outcome->m_number - 1 : -1);
+    for (int i = node->children.Length(); i >= 1; i--) {
+      stack.push_back(std::pair<GameTreeNodeRep *, int>(node->children[i], i));
+    }
+  }
+
+  int numNodes = nodes.size();
+  tree.m_childStart.assign(1, 0);
+  tree.m_children.clear();
+  for (int n = 0; n < numNodes; n++) {
+    for (int i = 1; i <= nodes[n]->children.Length(); i++) {
+      tree.m_children.push_back(nodeIndex[nodes[n]->children[i]]);
+    }
+    tree.m_childStart.push_back(tree.m_children.size());
+  }
+  tree.m_subtreeEnd.resize(numNodes);
+  for (int n = numNodes - 1; n >= 0; n--) {
+    int numChildren = tree.NumChildren(n);
+    tree.m_subtreeEnd[n] = (numChildren > 0) ?
+      tree.m_subtreeEnd[tree.GetChild(n, numChildren)] : n + 1;
+  }
+
+  tree.m_members.resize(tree.m_memberStart.back());
+  for (std::map<GameTreeInfosetRep *, int>::const_iterator it = index.begin();
+       it != index.end(); ++it) {
+    for (int i = 1; i <= it->first->m_members.Length(); i++) {
+      tree.m_members[tree.m_memberStart[it->second] + i - 1] = 
+	nodeIndex[it->first->m_members[i]];
+    }
+  }
+
+  m_compiledValid = true;
+}
+
 //------------------------------------------------------------------------
 //                  GameTreeRep: Writing data files
 //------------------------------------------------------------------------
@@ -886,6 +1045,134 @@ void GameTreeRep::WriteNfgFile(std::ostream &p_file) const
   GameRep::WriteNfgFile(p_file);
 }
 
+namespace {
+
+/// Node types in binary savefiles
+enum { BINARY_NODE_TERMINAL = 0, BINARY_NODE_CHANCE = 1,
+       BINARY_NODE_PERSONAL = 2 };
+
+}  // end anonymous namespace
+
+///
+/// Write the game to a binary savefile.  The body consists of the
+/// title and comment; the player labels; the outcomes; and then the
+/// nodes in preorder.  Each node is written as its label, its type,
+/// the player (for personal nodes) and number of its information set,
+/// the information set's label and actions if this is the first node
+/// in it, and the number of its outcome (zero for none).
+///
+void GameTreeRep::WriteBinaryFile(std::ostream &p_file) const
+{
+  BinaryFileWriter writer(BINARY_GAME_TREE);
+  writer.WriteString(GetTitle());
+  writer.WriteString(GetComment());
+  writer.WriteCount(m_players.Length());
+  for (int pl = 1; pl <= m_players.Length(); pl++) {
+    writer.WriteString(m_players[pl]->m_label);
+  }
+  WriteBinaryOutcomes(writer);
+
+  std::set<GameTreeInfosetRep *> written;
+  List<GameTreeNodeRep *> stack;
+  stack.Append(m_root);
+  while (stack.Length() > 0) {
+    GameTreeNodeRep *node = stack.Remove(stack.Length());
+    writer.WriteString(node->m_label);
+    GameTreeInfosetRep *infoset = node->infoset;
+    if (!infoset) {
+      writer.WriteCount(BINARY_NODE_TERMINAL);
+    }
+    else if (infoset->m_player == m_chance) {
+      writer.WriteCount(BINARY_NODE_CHANCE);
+    }
+    else {
+      writer.WriteCount(BINARY_NODE_PERSONAL);
+      writer.WriteCount(infoset->m_player->m_number);
+    }
+    if (infoset) {
+      writer.WriteCount(infoset->m_number);
+      if (written.insert(infoset).second) {
+	writer.WriteString(infoset->m_label);
+	writer.WriteCount(infoset->m_actions.Length());
+	for (int act = 1; act <= infoset->m_actions.Length(); act++) {
+	  writer.WriteString(infoset->m_actions[act]->m_label);
+	  if (infoset->m_player == m_chance) {
+	    writer.WriteNumber(infoset->m_probs[act]);
+	  }
+	}
+      }
+    }
+    writer.WriteCount((node->outcome) ? node->outcome->m_number : 0);
+    for (int i = node->children.Length(); i >= 1; i--) {
+      stack.Append(node->children[i]);
+    }
+  }
+  writer.Flush(p_file);
+}
+
+Game GameTreeRep::ReadBinaryFile(BinaryFileReader &p_file)
+{
+  GameTreeRep *efg = new GameTreeRep;
+  Game game = efg;
+  efg->SetCanonicalization(false);
+  efg->SetTitle(p_file.ReadString());
+  efg->SetComment(p_file.ReadString());
+  unsigned int numPlayers = p_file.ReadCount();
+  for (unsigned int pl = 1; pl <= numPlayers; pl++) {
+    efg->NewPlayer()->SetLabel(p_file.ReadString());
+  }
+  efg->ReadBinaryOutcomes(p_file);
+
+  // The information sets of each player, indexed by their numbers in
+  // the file; the chance player is at index zero
+  std::vector<std::map<unsigned int, GameInfoset> > infosets(numPlayers + 1);
+  List<GameTreeNodeRep *> stack;
+  stack.Append(efg->m_root);
+  while (stack.Length() > 0) {
+    GameTreeNodeRep *node = stack.Remove(stack.Length());
+    node->m_label = p_file.ReadString();
+    unsigned int type = p_file.ReadCount(BINARY_NODE_PERSONAL);
+    if (type != BINARY_NODE_TERMINAL) {
+      unsigned int pl = 0;
+      if (type == BINARY_NODE_PERSONAL) {
+	pl = p_file.ReadCount(numPlayers);
+	if (pl == 0) {
+	  throw InvalidFileException("Invalid player in binary savefile");
+	}
+      }
+      GamePlayer player = (pl > 0) ? efg->m_players[pl] : efg->m_chance;
+      unsigned int id = p_file.ReadCount();
+      std::map<unsigned int, GameInfoset>::const_iterator it =
+	infosets[pl].find(id);
+      if (it != infosets[pl].end()) {
+	node->AppendMove(it->second);
+      }
+      else {
+	std::string label = p_file.ReadString();
+	int numActions = p_file.ReadCount(p_file.Remaining() / 4);
+	GameTreeInfosetRep *infoset =
+	  dynamic_cast<GameTreeInfosetRep *>(node->AppendMove(player, numActions).operator->());
+	infosets[pl][id] = infoset;
+	infoset->m_label = label;
+	for (int act = 1; act <= numActions; act++) {
+	  infoset->m_actions[act]->m_label = p_file.ReadString();
+	  if (pl == 0) {
+	    infoset->m_probs[act] = p_file.ReadNumber();
+	  }
+	}
+      }
+    }
+    unsigned int outc = p_file.ReadCount(efg->m_outcomes.Length());
+    node->outcome = (outc > 0) ? efg->m_outcomes[outc] : 0;
+    for (int i = node->children.Length(); i >= 1; i--) {
+      stack.Append(node->children[i]);
+    }
+  }
+
+  efg->SetCanonicalization(true);
+  return game;
+}
+
 //------------------------------------------------------------------------
 //                 GameTreeRep: Dimensions of the game
 //------------------------------------------------------------------------
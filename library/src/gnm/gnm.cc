@@ -20,6 +20,7 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <vector>
 #include "gambit/gambit.h"
 #include "gambit/nash/gnm.h"
 #include "gambit/gtracer/gtracer.h"
@@ -40,10 +41,27 @@ NashGNMStrategySolver::ToProfile(const Game &p_game,
   return msp;
 }
 
+std::vector<int>
+NashGNMStrategySolver::GetPlayerClasses(const Game &p_game) const
+{
+  std::vector<int> classes;
+  if (m_symmetric) {
+    Array<int> cls = p_game->GetPlayerClasses();
+    for (int pl = 1; pl <= cls.Length(); pl++) {
+      classes.push_back(cls[pl] - 1);
+    }
+    if (classes.back() == p_game->NumPlayers() - 1) {
+      // No two players are interchangeable, so there is nothing to reduce
+      classes.clear();
+    }
+  }
+  return classes;
+}
+
 List<MixedStrategyProfile<double> >
-NashGNMStrategySolver::Solve(const Game &p_game,
-			     shared_ptr<gnmgame> p_rep,
-			     const cvector &p_pert) const
+NashGNMStrategySolver::Solve(const Game &p_game, gnmgame &p_rep,
+			     const cvector &p_pert,
+			     const std::vector<int> &p_classes) const
 {
   const int STEPS = 100;
   const double FUZZ = 1e-12;
@@ -58,13 +76,32 @@ NashGNMStrategySolver::Solve(const Game &p_game,
   if (m_verbose) {
     m_onEquilibrium->Render(ToProfile(p_game, p_pert), "pert");
   }
-  cvector norm_pert = p_pert / p_pert.norm(); 
+  // In symmetric mode, trace in the game whose players are the classes,
+  // from the sum of the perturbations of the members of each class
+  shared_ptr<symgame> sym;
+  gnmgame *rep = &p_rep;
+  cvector pert(p_pert);
+  if (!p_classes.empty()) {
+    sym = new symgame(p_rep, p_classes);
+    rep = sym.get();
+    pert = cvector(sym->getNumActions());
+    sym->fold(pert, p_pert);
+  }
+
+  cvector norm_pert = pert / pert.norm(); 
   cvector **answers;
-  int numEq = GNM(*p_rep, norm_pert, answers,
+  int numEq = GNM(*rep, norm_pert, answers,
 		  STEPS, FUZZ, LNMFREQ, LNMMAX, LAMBDAMIN, WOBBLE, THRESHOLD,
 		  m_verbose);
+  cvector full(p_rep.getNumActions());
   for (int i = 0; i < numEq; i++) {
-    eqa.push_back(ToProfile(p_game, *answers[i]));
+    if (sym.get()) {
+      sym->expand(full, *answers[i]);
+      eqa.push_back(ToProfile(p_game, full));
+    }
+    else {
+      eqa.push_back(ToProfile(p_game, *answers[i]));
+    }
     m_onEquilibrium->Render(eqa.back());
     free(answers[i]);
   }
@@ -122,7 +159,7 @@ NashGNMStrategySolver::Solve(const Game &p_game) const
   for (int i = 1; i < A->getNumActions(); i++) {
     g[i] = 0.0;
   }
-  return Solve(p_game, A, g);
+  return Solve(p_game, *A, g, GetPlayerClasses(p_game));
 }
 
 List<MixedStrategyProfile<double> >
@@ -140,7 +177,62 @@ NashGNMStrategySolver::Solve(const Game &p_game,
     g[i] = p_pert[i+1];
   }
   g /= g.norm();
-  return Solve(p_game, A, g);
+  return Solve(p_game, *A, g, GetPlayerClasses(p_game));
+}
+
+//
+// The representation of a table game is built once, and only read while
+// tracing, so it is shared by all threads.  The representation of an
+// action-graph game keeps working data in the game, so each thread
+// traces on a representation of its own copy of the game.
+//
+List<MixedStrategyProfile<double> >
+NashGNMStrategySolver::Solve(const Game &p_game,
+			     const List<MixedStrategyProfile<double> > &p_perts) const
+{
+  if (!p_game->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+
+  std::vector<cvector> perts;
+  for (int k = 1; k <= p_perts.size(); k++) {
+    cvector g(p_perts[k].MixedProfileLength());
+    for (int i = 0; i < g.getm(); i++) {
+      g[i] = p_perts[k][i+1];
+    }
+    g /= g.norm();
+    perts.push_back(g);
+  }
+
+  std::vector<int> classes = GetPlayerClasses(p_game);
+  shared_ptr<gnmgame> A;
+  if (!p_game->IsAgg()) {
+    A = BuildRepresentation(p_game);
+  }
+  ProfileSweep<double> sweep(p_game, perts.size(), m_tolerance, *m_onEquilibrium);
+
+#pragma omp parallel for schedule(dynamic, 1)
+  for (int k = 1; k <= (int) perts.size(); k++) {
+    try {
+      const Game &game = sweep.GetThreadGame();
+      NashGNMStrategySolver solver(sweep.GetRecorder(k), m_verbose,
+				   m_tolerance, m_symmetric);
+      if (A.get()) {
+	solver.Solve(game, *A, perts[k-1], classes);
+      }
+      else {
+	aggame rep(dynamic_cast<GameAggRep &>(*game));
+	solver.Solve(game, rep, perts[k-1], classes);
+      }
+    }
+    catch (std::runtime_error &e) {
+      sweep.Fail(e.what());
+    }
+    sweep.Finish(k);
+  }
+
+  sweep.CheckErrors();
+  return sweep.GetEquilibria();
 }
 
 }  // end namespace Gambit::Nash
@@ -26,23 +26,29 @@
 namespace Gambit {
 namespace gametracer {
 
-void aggame::computePartialP_PureNode(int player1,int act1, std::vector<int>& tasks){
+void aggame::computePartialP_PureNode(int player1,int act1, std::vector<int>& tasks, cvector &s){
     int i,j,Node = aggPtr->actionSets[player1][act1];
     int numNei = aggPtr->neighbors[Node].size();
 
     //assert(aggPtr->isPure[Node]||tasks.size()==0);
     std::vector<agg::AggNumber> strat (numNei);
     agg::AGG::config    a(numNei,0);
-    //compute the full distrib
-    aggPtr->computeP (player1,act1);
-
-    //store the full distrib in Pr[player1]
-    aggPtr->Pr[player1].swap(aggPtr->Pr[numPlayers-1]);
+    //compute the full distrib, if possible from the distrib induced by
+    //the others, which is obtained by division
+    if (aggPtr->isPure[Node] && aggPtr->divideFullP(Node,player1,s.values())) {
+      agg::aggdistrib own, full;
+      own.insert(make_pair(aggPtr->projection[Node][player1][act1],1.0));
+      full.multiply(aggPtr->Pr[numPlayers-1],own,numNei,aggPtr->projFunctions[Node]);
+      aggPtr->Pr[player1].swap(full);
+    }
+    else {
+      aggPtr->computeP (player1,act1);
+      //store the full distrib in Pr[player1]
+      aggPtr->Pr[player1].swap(aggPtr->Pr[numPlayers-1]);
+    }
     for(i=0;i<(int)tasks.size();i++){
       //assert(tasks[i]!=player1);
       agg::aggdistrib& P = aggPtr->Pr[tasks[i]];
-      //P.clear();  // to get ready for division, we need clear()
-      P=aggPtr->Pr[player1];
 
       bool NullOnly =true;
       for(j=0;j<numNei;++j){
@@ -60,12 +66,22 @@ void aggame::computePartialP_PureNode(int player1,int act1, std::vector<int>& ta
       }
 #ifdef AGGDEBUG
       cout<<"dividing "<<endl;
-      P.print_in_order();
+      aggPtr->Pr[player1].print_in_order();
       cout<<endl<<"by [";
       copy(strat.begin(),strat.end(),ostream_iterator<agg::AggNumber>(cout," ") );
       cout<<"]\n";
 #endif
-      if (!NullOnly) P/= strat;
+      //divide stably by the null term where possible, otherwise by
+      //the first neighbor played with positive probability
+      if (NullOnly) {
+	P=aggPtr->Pr[player1];
+      }
+      else if (!agg::AGG::divide(P,aggPtr->Pr[player1],
+				 aggPtr->projectedStrat[Node][tasks[i]],numNei)) {
+	//P.clear();  // to get ready for division, we need clear()
+	P=aggPtr->Pr[player1];
+	P/= strat;
+      }
 #ifdef AGGDEBUG
       cout<<"result is: "<<endl;
       P.print_in_order();
@@ -144,8 +160,8 @@ void aggame::payoffMatrix(cmatrix &dest, cvector &s, agg::AggNumber fuzz){
 #endif
   agg::AggNumber fuzzcount;
   int rown, coln, rowi, coli,act1,act2,currNode,numNei;
-  static std::vector<int>::iterator p;
-  static std::vector<int> tasks,spares,nontasks;
+  std::vector<int>::iterator p;
+  std::vector<int> tasks,spares,nontasks;
   tasks.reserve(aggPtr->numPlayers);
   spares.reserve(aggPtr->numPlayers);
   nontasks.reserve(aggPtr->numPlayers);
@@ -197,7 +213,7 @@ void aggame::payoffMatrix(cmatrix &dest, cvector &s, agg::AggNumber fuzz){
                 copy(key.begin(),key.end(),ostream_iterator<int>(cout," ") );
                 cout<<"]\n";
 #endif
-	        agg::aggdistrib::iterator r= aggPtr->cache.findExact(key);
+	        agg::trie_map<agg::AggNumber>::iterator r= aggPtr->cache.findExact(key);
 	        if (r!=aggPtr->cache.end()){
 	          dest[act1+firstAction(rown)][act2+firstAction(coln)]=r->second;
 	        }
@@ -230,7 +246,7 @@ void aggame::payoffMatrix(cmatrix &dest, cvector &s, agg::AggNumber fuzz){
 	    if (tasks.size()==0 && spares.size()==0) continue; //nothing to be done for this row
 
 	    if(aggPtr->isPure[currNode]||tasks.size()==0){
-	      computePartialP_PureNode(rown, act1,tasks);
+	      computePartialP_PureNode(rown, act1,tasks,s);
 	    }else{//do bisection
 	      computePartialP_bisect(rown,act1,tasks.begin(),tasks.end(),aggPtr->Pr[rown]);
 #ifdef AGGDEBUG
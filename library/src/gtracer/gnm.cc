@@ -83,6 +83,9 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
 
   int N = A.getNumPlayers(), 
     M = A.getNumActions(); // the two most important cvector sizes, stored locally for brevity
+  // the degree of the payoffs as polynomials in the strategy profile;
+  // by Euler's theorem, DG*sigma is this multiple of the payoff vector
+  int D = A.getPayoffDegree();
   double bestPayoff, 
     det, // determinant of the jacobian
     newV, // utility variable
@@ -152,7 +155,7 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
 
   A.payoffMatrix(DG, sigma, fuzz);
   DG.multiply(sigma, v);
-  v /= (double)(N-1);
+  v /= (double)D;
 
   // Scale g until the equilibrium sigma calculated above
   // is in fact the one unique equilibrium, and set lambda
@@ -195,7 +198,7 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
       g[i] *= (V-yn1[n])/G[n];
     }
 */
-  if(N <= 2) { // ensure we don't do small steps and LNM
+  if(D <= 1) { // ensure we don't do small steps and LNM
     LNMFreq = 0;
     steps = 1;
   }
@@ -239,11 +242,11 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
       
       //Calculate payoff cvector
       DG.multiply(sigma, v);      
-      v /=  (double)(N-1);
+      v /=  (double)D;
       ym1 = g;
       ym1 *= lambda;
       v += ym1;
-      // v = DG*sigma / (double)(N-1) + g * lambda;
+      // v = DG*sigma / (double)D + g * lambda;
       
       //Find next action that will enter or leave the support
       //This bit pretends that z and v change linearly and calculates
@@ -289,7 +292,7 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
       if(Index*(lambda+dlambda*delta) <= 0.0) {
 	// if there's no next support boundary, treat the equilibrium
 	// as the next support boundary and step up to it incrementally
-	if(minBound == BIGFLOAT && N > 2 && stepsLeft > 1) { 
+	if(minBound == BIGFLOAT && D > 1 && stepsLeft > 1) { 
 	  del = -lambda / dlambda;
 	  delta = del / stepsLeft;
 	} else {
@@ -302,7 +305,7 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
 	  A.retract(sigma, z);
 	  A.payoffMatrix(DG, sigma, fuzz);
 	  ee = 0.0;
-	  if(N > 2) { // if N=2, the graph is linear, so we are at a
+	  if(D > 1) { // if D=1, the graph is linear, so we are at a
 	    //precise equilibrium.  otherwise, refine it.
 	    J = DG;
 	    J += I;
@@ -361,11 +364,11 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
       A.retract(sigma,z);
       A.payoffMatrix(DG, sigma,fuzz);
       
-      if(N <= 2) 
+      if(D <= 1) 
 	break; // already at the support boundary
       
       DG.multiply(sigma,err);
-      err /= (double)(N-1);
+      err /= (double)D;
       g0 = g;
       g0 *= lambda;
       err += g0;
@@ -380,12 +383,12 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
       if(ee > threshold) { // if we've accumulated too much error, either
 	if(wobble) {       // wobble or quit.
 	  DG.multiply(sigma, ym1);
-	  ym1 /= (double)(N-1);
+	  ym1 /= (double)D;
 	  g = z;
 	  g -= sigma;
 	  g -= ym1;
 	  g /= lambda;
-	  // g = ((z-sigma)-((DG*sigma) / (double)(N-1)))/lambda;
+	  // g = ((z-sigma)-((DG*sigma) / (double)D))/lambda;
 	} else {
 	  if(verbose) {
 	    std::cerr << "gnm(): return due to too much error. error is " << ee << std::endl;
@@ -429,15 +432,15 @@ int GNM(gnmgame &A, cvector &g, cvector **&Eq, int steps, double fuzz, int LNMFr
     // z = (z-x)+sigma;
      
     // wobble the perturbation cvector to put us back on an equilibrium
-    if(N > 2 && wobble) {
+    if(D > 1 && wobble) {
       A.payoffMatrix(DG, sigma, fuzz);
       DG.multiply(sigma, ym1);
-      ym1 /= (double)(N-1);
+      ym1 /= (double)D;
       g = z;
       g -= sigma;
       g -= ym1;
       g /= lambda;
-      // g = ((z-sigma)-((DG*sigma) / (double)(N-1)))/lambda;
+      // g = ((z-sigma)-((DG*sigma) / (double)D))/lambda;
 
     }
   }
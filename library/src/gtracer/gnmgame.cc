@@ -205,9 +205,9 @@ double gnmgame::LNM(cvector &z, const cvector &g, double det, cmatrix &J, cmatri
   if(MaxLNM >= 1 && det != 0.0) {
     b = 1.0/det;
     for(k = 0; k < MaxLNM; k++) {
-      //      del = z - s - DG*s / (double)(numPlayers - 1) - g; 
+      //      del = z - s - DG*s / (double)getPayoffDegree() - g; 
       DG.multiply(s,del);
-      del /= (double)(numPlayers - 1);
+      del /= (double)getPayoffDegree();
       del += g;
       del += s;
       del -= z;
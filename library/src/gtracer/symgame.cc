@@ -0,0 +1,150 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/src/gtracer/symgame.cc
+// Restriction of a game for Gametracer to symmetric strategy profiles
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <vector>
+#include "gambit/gambit.h"
+#include "gambit/gtracer/cmatrix.h"
+#include "gambit/gtracer/symgame.h"
+
+namespace Gambit {
+namespace gametracer {
+
+std::vector<int> symgame::classActions(gnmgame &base,
+				       const std::vector<int> &classes)
+{
+  std::vector<int> actions;
+  for (int p = 0; p < base.getNumPlayers(); p++) {
+    if (classes[p] == (int) actions.size()) {
+      actions.push_back(base.getNumActions(p));
+    }
+    else if (classes[p] > (int) actions.size() ||
+	     actions[classes[p]] != base.getNumActions(p)) {
+      throw Gambit::DimensionException();
+    }
+  }
+  return actions;
+}
+
+symgame::symgame(gnmgame &base, const std::vector<int> &classes)
+  : gnmgame(classActions(base, classes).size(),
+	    &classActions(base, classes)[0]),
+    base(base), playerClass(classes)
+{
+  for (int p = 0; p < base.getNumPlayers(); p++) {
+    if (playerClass[p] == (int) representative.size()) {
+      representative.push_back(p);
+    }
+  }
+
+  native = (base.getNumPlayerClasses() == numPlayers);
+  for (int p = 0; native && p < base.getNumPlayers(); p++) {
+    native = (base.getClassOfPlayer(p) == playerClass[p]);
+  }
+}
+
+void symgame::expand(cvector &dest, const cvector &s)
+{
+  for (int p = 0; p < base.getNumPlayers(); p++) {
+    int offs = firstAction(playerClass[p]);
+    for (int a = 0; a < base.getNumActions(p); a++) {
+      dest[base.firstAction(p) + a] = s[offs + a];
+    }
+  }
+}
+
+void symgame::fold(cvector &dest, const cvector &v)
+{
+  dest = 0.0;
+  for (int p = 0; p < base.getNumPlayers(); p++) {
+    int offs = firstAction(playerClass[p]);
+    for (int a = 0; a < base.getNumActions(p); a++) {
+      dest[offs + a] += v[base.firstAction(p) + a];
+    }
+  }
+}
+
+double symgame::getPurePayoff(int cls, int *s)
+{
+  std::vector<int> full(base.getNumPlayers());
+  for (int p = 0; p < base.getNumPlayers(); p++) {
+    full[p] = s[playerClass[p]];
+  }
+  return base.getPurePayoff(representative[cls], &full[0]);
+}
+
+double symgame::getMixedPayoff(int cls, cvector &s)
+{
+  if (native) {
+    return base.getKSymMixedPayoff(cls, s);
+  }
+  cvector full(base.getNumActions());
+  expand(full, s);
+  return base.getMixedPayoff(representative[cls], full);
+}
+
+void symgame::getPayoffVector(cvector &dest, int cls, const cvector &s)
+{
+  if (native) {
+    base.getKSymPayoffVector(dest, cls, const_cast<cvector &>(s));
+    return;
+  }
+  cvector full(base.getNumActions());
+  expand(full, s);
+  base.getPayoffVector(dest, representative[cls], full);
+}
+
+//
+// The derivative of the payoff to a class with respect to the strategy
+// of a class is the sum of the derivatives of the payoff to its first
+// member with respect to the strategies of the members.
+//
+void symgame::payoffMatrix(cmatrix &dest, cvector &s, double fuzz)
+{
+  if (native) {
+    base.payoffMatrix(dest, s, fuzz, true);
+    return;
+  }
+  int M = base.getNumActions();
+  cvector full(M);
+  cmatrix fullDG(M, M);
+  expand(full, s);
+  base.payoffMatrix(fullDG, full, fuzz);
+
+  for (int cls = 0; cls < numPlayers; cls++) {
+    int rep = representative[cls];
+    for (int a = 0; a < actions[cls]; a++) {
+      int row = base.firstAction(rep) + a;
+      for (int j = 0; j < numActions; j++) {
+	dest[firstAction(cls) + a][j] = 0.0;
+      }
+      for (int p = 0; p < base.getNumPlayers(); p++) {
+	int offs = firstAction(playerClass[p]);
+	for (int b = 0; b < base.getNumActions(p); b++) {
+	  dest[firstAction(cls) + a][offs + b] += fullDG[row][base.firstAction(p) + b];
+	}
+      }
+    }
+  }
+}
+
+}  // end namespace Gambit::gametracer
+}  // end namespace Gambit
@@ -41,6 +41,7 @@ Foundation, 675 Mass Ave, Cambridge, MA 02139, USA.
 #include <cfloat>
 #include <climits>
 #include <cmath>
+#include <cstdlib>
 #include <cstring>
 #include "gambit/gambit.h"
 
@@ -122,6 +123,101 @@ inline static unsigned long up(unsigned long x)
   return x << I_SHIFT;
 }
 
+//
+// Small values are held in a machine word, and most operations on them
+// are done directly.  When an operation would overflow, or involves a
+// value which does not fit, the operands are passed to the
+// multiple-precision routines above; IntegerRepRef presents a small
+// value to these routines as a temporary representation on the stack.
+//
+
+class IntegerRepRef {
+private:
+  union {
+    IntegerRep rep;
+    unsigned short buf[3 + sizeof(long) / sizeof(short) + 1];
+  } m_local;
+  const IntegerRep *m_rep;
+
+  void SetLocal(long x)
+  {
+    unsigned long u = (x < 0) ? -((unsigned long) x) : x;
+    unsigned short len = 0;
+    while (u != 0) {
+      m_local.rep.s[len++] = extract(u);
+      u >>= I_SHIFT;
+    }
+    m_local.rep.len = len;
+    m_local.rep.sz = 0;
+    m_local.rep.sgn = (x >= 0) ? I_POSITIVE : I_NEGATIVE;
+    m_rep = &m_local.rep;
+  }
+
+public:
+  IntegerRepRef(const Integer &x)
+  {
+    if (x.rep)
+      m_rep = x.rep;
+    else
+      SetLocal(x.m_small);
+  }
+  IntegerRepRef(long x)  { SetLocal(x); }
+
+  operator const IntegerRep *(void) const { return m_rep; }
+};
+
+//
+// Machine arithmetic on small values.  These return false if the result
+// overflows, or is LONG_MIN, which is not held as a small value.
+//
+
+#if defined(__GNUC__) && (__GNUC__ >= 5 || defined(__clang__))
+
+inline static bool small_add(long x, long y, long &z)
+{ return !__builtin_add_overflow(x, y, &z) && z != LONG_MIN; }
+
+inline static bool small_sub(long x, long y, long &z)
+{ return !__builtin_sub_overflow(x, y, &z) && z != LONG_MIN; }
+
+inline static bool small_mul(long x, long y, long &z)
+{ return !__builtin_mul_overflow(x, y, &z) && z != LONG_MIN; }
+
+#else
+
+inline static bool small_add(long x, long y, long &z)
+{
+  if ((y > 0 && x > LONG_MAX - y) || (y < 0 && x <= LONG_MIN - y))  return false;
+  z = x + y;
+  return true;
+}
+
+inline static bool small_sub(long x, long y, long &z)
+{
+  if ((y < 0 && x > LONG_MAX + y) || (y > 0 && x <= LONG_MIN + y))  return false;
+  z = x - y;
+  return true;
+}
+
+inline static bool small_mul(long x, long y, long &z)
+{
+  if (x == 0 || y == 0) {
+    z = 0;
+    return true;
+  }
+  if (x == LONG_MIN || y == LONG_MIN)  return false;
+  unsigned long ux = (x < 0) ? -x : x, uy = (y < 0) ? -y : y;
+  if (ux > (unsigned long) LONG_MAX / uy)  return false;
+  z = x * y;
+  return true;
+}
+
+#endif  // __GNUC__
+
+inline static int small_compare(long x, long y)
+{
+  return (x < y) ? -1 : ((x > y) ? 1 : 0);
+}
+
 // compare two equal-length reps
 
 static int docmp(const unsigned short* x, const unsigned short* y, int l)
@@ -322,7 +418,7 @@ IntegerRep* Icopy_ulong(IntegerRep* old, unsigned long x)
   while (x != 0)
   {
     src[srclen++] = extract(x);
-    x = down(x);
+    x >>= I_SHIFT;
   }
 
   IntegerRep* rep;
@@ -491,6 +587,14 @@ int Iisdouble(const IntegerRep* rep)
 
 double ratio(const Integer& num, const Integer& den)
 {
+  // Small values which are exactly representable as doubles give a
+  // correctly-rounded quotient by a single division
+  const long exact = 1L << (DBL_MANT_DIG - 1);
+  if (!num.rep && !den.rep && den.m_small != 0 &&
+      labs(num.m_small) <= exact && labs(den.m_small) <= exact) {
+    return (double) num.m_small / (double) den.m_small;
+  }
+
   Integer q, r;
   divide(num, den, q, r);
   double d1 = q.as_double();
@@ -502,7 +606,9 @@ double ratio(const Integer& num, const Integer& den)
     double  d2 = 0.0;
     double  d3 = 0.0; 
     int cont = 1;
-    for (int i = den.rep->len - 1; i >= 0 && cont; --i)
+    IntegerRepRef dr(den), rr(r);
+    const IntegerRep *drep = dr, *rrep = rr;
+    for (int i = drep->len - 1; i >= 0 && cont; --i)
     {
 		unsigned short a = (unsigned short) (I_RADIX >> 1);
       while (a != 0)
@@ -514,13 +620,13 @@ double ratio(const Integer& num, const Integer& den)
         }
 
         d2 *= 2.0;
-        if (den.rep->s[i] & a)
+        if (drep->s[i] & a)
           d2 += 1.0;
 
-        if (i < r.rep->len)
+        if (i < rrep->len)
         {
           d3 *= 2.0;
-          if (r.rep->s[i] & a)
+          if (rrep->s[i] & a)
             d3 += 1.0;
         }
 
@@ -1349,94 +1455,37 @@ IntegerRep* div(const IntegerRep* x, long y, IntegerRep* q)
 
 void divide(const Integer& Ix, long y, Integer& Iq, long& rem)
 {
-  const IntegerRep* x = Ix.rep;
-  nonnil(x);
-  IntegerRep* q = Iq.rep;
-  int xl = x->len;
-  if (y == 0) {
-    throw Gambit::ZeroDivideException();
-  }
-  unsigned short ys[SHORT_PER_LONG];
-  unsigned long u;
-  int ysgn = y >= 0;
-  if (ysgn)
-    u = y;
-  else
-    u = -y;
-  int yl = 0;
-  while (u != 0)
-  {
-    ys[yl++] = extract(u);
-    u = down(u);
-  }
-
-  int comp = xl - yl;
-  if (comp == 0) comp = docmp(x->s, ys, xl);
-
-  int xsgn = x->sgn;
-  int samesign = xsgn == ysgn;
-
-  if (comp < 0)
-  {
-    rem = Itolong(x);
-    q = Icopy_zero(q);
-  }
-  else if (comp == 0)
-  {
-    q = Icopy_one(q, samesign);
-    rem = 0;
-  }
-  else if (yl == 1)
-  {
-    q = Icopy(q, x);
-    rem = unscale(q->s, q->len, ys[0], q->s);
-  }
-  else
-  {
-    IntegerRep* r  = 0;
-	 unsigned short prescale = (unsigned short) (I_RADIX / (1 + ys[yl - 1]));
-    if (prescale != 1)
-    {
-      unsigned long prod = (unsigned long)prescale * (unsigned long)ys[0];
-      ys[0] = extract(prod);
-      prod = down(prod) + (unsigned long)prescale * (unsigned long)ys[1];
-      ys[1] = extract(prod);
-      r = multiply(x, ((long)prescale & I_MAXNUM), r);
-    }
-    else
-    {
-      r = Icalloc(r, xl + 1);
-      scpy(x->s, r->s, xl);
+  if (!Ix.rep) {
+    if (y == 0) {
+      throw Gambit::ZeroDivideException();
     }
-
-    int ql = xl - yl + 1;
-      
-    q = Icalloc(q, ql);
-    
-    do_divide(r->s, ys, yl, q->s, ql);
-
-    if (prescale != 1)
-    {
-      Icheck(r);
-      unscale(r->s, r->len, prescale, r->s);
-    }
-    Icheck(r);
-    rem = Itolong(r);
-    if (!STATIC_IntegerRep(r)) delete r;
+    long xs = Ix.m_small;
+    rem = xs % y;
+    Iq.SetSmall(xs / y);
+    return;
   }
-  rem = abs(Integer(rem)).as_long();
-  if (xsgn == I_NEGATIVE) rem = -rem;
-  q->sgn = samesign;
-  Icheck(q);
-  Iq.rep = q;
+  // The remainder is smaller in magnitude than y, so it fits in a long
+  Integer r;
+  divide(Ix, Integer(y), Iq, r);
+  rem = r.as_long();
 }
 
 
 void divide(const Integer& Ix, const Integer& Iy, Integer& Iq, Integer& Ir)
 {
-  const IntegerRep* x = Ix.rep;
+  if (!Ix.rep && !Iy.rep) {
+    if (Iy.m_small == 0) {
+      throw Gambit::ZeroDivideException();
+    }
+    long xs = Ix.m_small, ys = Iy.m_small;
+    Iq.SetSmall(xs / ys);
+    Ir.SetSmall(xs % ys);
+    return;
+  }
+  IntegerRepRef xr(Ix), yr(Iy);
+  const IntegerRep* x = xr;
   nonnil(x);
-  const IntegerRep* y = Iy.rep;
+  const IntegerRep* y = yr;
   nonnil(y);
   IntegerRep* q = Iq.rep;
   IntegerRep* r = Ir.rep;
@@ -1500,9 +1549,9 @@ void divide(const Integer& Ix, const Integer& Iy, Integer& Iq, Integer& Ir)
   }
   q->sgn = samesign;
   Icheck(q);
-  Iq.rep = q;
+  Iq.Assign(q);
   Icheck(r);
-  Ir.rep = r;
+  Ir.Assign(r);
 }
 
 IntegerRep* mod(const IntegerRep* x, const IntegerRep* y, IntegerRep* r)
@@ -1856,11 +1905,12 @@ void (setbit)(Integer& x, long b)
   {
 	 int bw = (int) ((unsigned long)b / I_SHIFT);
 	 int sw = (int) ((unsigned long)b % I_SHIFT);
-    int xl = x.rep ? x.rep->len : 0;
+    int xl = x.Promote()->len;
     if (xl <= bw)
       x.rep = Iresize(x.rep, calc_len(xl, bw+1, 0));
     x.rep->s[bw] |= (1 << sw);
     Icheck(x.rep);
+    x.Assign(x.rep);
   }
 }
 
@@ -1868,26 +1918,24 @@ void clearbit(Integer& x, long b)
 {
   if (b >= 0)
     {
-      if (x.rep == 0)
-	x.rep = &_ZeroRep;
-      else
-	{
-	  int bw = (int) ((unsigned long)b / I_SHIFT);
-	  int sw = (int) ((unsigned long)b % I_SHIFT);
-	  if (x.rep->len > bw)
-	    x.rep->s[bw] &= ~(1 << sw);
-	}
+      int bw = (int) ((unsigned long)b / I_SHIFT);
+      int sw = (int) ((unsigned long)b % I_SHIFT);
+      if (x.Promote()->len > bw)
+	x.rep->s[bw] &= ~(1 << sw);
     Icheck(x.rep);
+    x.Assign(x.rep);
   }
 }
 
 int testbit(const Integer& x, long b)
 {
-  if (x.rep != 0 && b >= 0)
+  if (b >= 0)
   {
 	 int bw = (int) ((unsigned long)b / I_SHIFT);
 	 int sw = (int) ((unsigned long)b % I_SHIFT);
-    return (bw < x.rep->len && (x.rep->s[bw] & (1 << sw)) != 0);
+    IntegerRepRef xr(x);
+    const IntegerRep *xrep = xr;
+    return (bw < xrep->len && (xrep->s[bw] & (1 << sw)) != 0);
   }
   else
     return 0;
@@ -2196,7 +2244,7 @@ std::string Itoa(const IntegerRep *x, int base, int width)
 
 std::ostream &operator<<(std::ostream &s, const Integer &y)
 {
-  return s << Itoa(y.rep);
+  return s << Itoa(IntegerRepRef(y));
 }
 
 std::string cvtItoa(const IntegerRep *x, std::string fmt, int& fmtlen, int base, int showbase,
@@ -2295,7 +2343,7 @@ std::istream &operator>>(std::istream &s, Integer& y)
 {
   char sgn = 0;
   char ch;
-  y.rep = Icopy_zero(y.rep);
+  y = 0L;
 
   do  {
 	 s.get(ch);
@@ -2334,6 +2382,8 @@ std::istream &operator>>(std::istream &s, Integer& y)
 
 int Integer::OK() const
 {
+  if (rep == 0 && m_small != LONG_MIN)
+    return 1;
   if (rep != 0)
 	 {
       int l = rep->len;
@@ -2358,181 +2408,282 @@ void Integer::error(const char* msg) const
 
 
 
+void Integer::SetSmall(long y)
+{
+  if (rep && !STATIC_IntegerRep(rep))  delete[] rep;
+  rep = 0;
+  m_small = y;
+}
+
+IntegerRep *Integer::Promote(void)
+{
+  if (!rep)  rep = Icopy_long(0, m_small);
+  return rep;
+}
+
+void Integer::Assign(IntegerRep *r)
+{
+  rep = r;
+  if (Iislong(rep)) {
+    long y = Itolong(rep);
+    if (y != LONG_MIN)  SetSmall(y);
+  }
+}
+
 // The following were moved from the header file to stop BC from squealing
 // endless quantities of warnings
 
-Integer::Integer() :rep(&_ZeroRep) {}
+Integer::Integer() : rep(0), m_small(0) {}
 
-Integer::Integer(IntegerRep* r) :rep(r) {}
+Integer::Integer(IntegerRep* r) : rep(0), m_small(0) { Assign(r); }
 
-Integer::Integer(int y) :rep(Icopy_long(0, (long)y)) {}
+Integer::Integer(int y) : rep(0), m_small(y)
+{
+  if ((long) y == LONG_MIN)  rep = Icopy_long(0, (long) y);
+}
 
-Integer::Integer(long y) :rep(Icopy_long(0, y)) {}
+Integer::Integer(long y) : rep(0), m_small(y)
+{
+  if (y == LONG_MIN)  rep = Icopy_long(0, y);
+}
 
-Integer::Integer(unsigned long y) :rep(Icopy_ulong(0, y)) {}
+Integer::Integer(unsigned long y) : rep(0), m_small(0)
+{
+  if (y <= (unsigned long) LONG_MAX)
+    m_small = (long) y;
+  else
+    rep = Icopy_ulong(0, y);
+}
 
-Integer::Integer(const Integer&  y) :rep(Icopy(0, y.rep)) {}
+Integer::Integer(const Integer&  y)
+  : rep((y.rep) ? Icopy(0, y.rep) : 0), m_small(y.m_small) {}
 
 Integer::~Integer() { if (rep && !STATIC_IntegerRep(rep)) delete[] rep; }
 
 Integer &Integer::operator=(const Integer &y)
 {
-  rep = Icopy(rep, y.rep);
+  if (this == &y)  return *this;
+  if (!y.rep)
+    SetSmall(y.m_small);
+  else
+    rep = Icopy(rep, y.rep);
   return *this;
 }
 
 Integer &Integer::operator=(long y)
 {
-  rep = Icopy_long(rep, y); 
+  if (y != LONG_MIN)
+    SetSmall(y);
+  else
+    rep = Icopy_long(rep, y); 
   return *this;
 }
 
 int Integer::initialized() const
 {
-  return rep != 0;
+  return rep != 0 || m_small != LONG_MIN;
 }
 
 // procedural versions
 
 int compare(const Integer& x, const Integer& y)
 {
-  return compare(x.rep, y.rep);
+  if (!x.rep && !y.rep)  return small_compare(x.m_small, y.m_small);
+  return compare(IntegerRepRef(x), IntegerRepRef(y));
 }
 
 int ucompare(const Integer& x, const Integer& y)
 {
-  return ucompare(x.rep, y.rep);
+  if (!x.rep && !y.rep)
+    return small_compare(labs(x.m_small), labs(y.m_small));
+  return ucompare(IntegerRepRef(x), IntegerRepRef(y));
 }
 
 int compare(const Integer& x, long y)
 {
-  return compare(x.rep, y);
+  if (!x.rep)  return small_compare(x.m_small, y);
+  return compare(x.rep, IntegerRepRef(y));
 }
 
 int ucompare(const Integer& x, long y)
 {
-  return ucompare(x.rep, y);
+  if (!x.rep && y != LONG_MIN)  return small_compare(labs(x.m_small), labs(y));
+  return ucompare(IntegerRepRef(x), IntegerRepRef(y));
 }
 
 int compare(long x, const Integer& y)
 {
-  return -compare(y.rep, x);
+  return -compare(y, x);
 }
 
 int ucompare(long x, const Integer& y)
 {
-  return -ucompare(y.rep, x);
+  return -ucompare(y, x);
 }
 
 void  add(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = add(x.rep, 0, y.rep, 0, dest.rep);
+  long z;
+  if (!x.rep && !y.rep && small_add(x.m_small, y.m_small, z))
+    dest.SetSmall(z);
+  else
+    dest.Assign(add(IntegerRepRef(x), 0, IntegerRepRef(y), 0, dest.rep));
 }
 
 void  sub(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = add(x.rep, 0, y.rep, 1, dest.rep);
+  long z;
+  if (!x.rep && !y.rep && small_sub(x.m_small, y.m_small, z))
+    dest.SetSmall(z);
+  else
+    dest.Assign(add(IntegerRepRef(x), 0, IntegerRepRef(y), 1, dest.rep));
 }
 
 void  mul(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = multiply(x.rep, y.rep, dest.rep);
+  long z;
+  if (!x.rep && !y.rep && small_mul(x.m_small, y.m_small, z))
+    dest.SetSmall(z);
+  else
+    dest.Assign(multiply(IntegerRepRef(x), IntegerRepRef(y), dest.rep));
 }
 
 void  div(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = div(x.rep, y.rep, dest.rep);
+  if (!x.rep && !y.rep) {
+    if (y.m_small == 0)  throw Gambit::ZeroDivideException();
+    dest.SetSmall(x.m_small / y.m_small);
+  }
+  else
+    dest.Assign(div(IntegerRepRef(x), IntegerRepRef(y), dest.rep));
 }
 
 void  mod(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = mod(x.rep, y.rep, dest.rep);
+  if (!x.rep && !y.rep) {
+    if (y.m_small == 0)  throw Gambit::ZeroDivideException();
+    dest.SetSmall(x.m_small % y.m_small);
+  }
+  else
+    dest.Assign(mod(IntegerRepRef(x), IntegerRepRef(y), dest.rep));
 }
 
 void  lshift(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = lshift(x.rep, y.rep, 0, dest.rep);
+  dest.Assign(lshift(IntegerRepRef(x), IntegerRepRef(y), 0, dest.rep));
 }
 
 void  rshift(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = lshift(x.rep, y.rep, 1, dest.rep);
+  dest.Assign(lshift(IntegerRepRef(x), IntegerRepRef(y), 1, dest.rep));
 }
 
 void  pow(const Integer& x, const Integer& y, Integer& dest)
 {
-  dest.rep = power(x.rep, Itolong(y.rep), dest.rep); // not incorrect
+  dest.Assign(power(IntegerRepRef(x), y.as_long(), dest.rep)); // not incorrect
 }
 
 void  add(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = add(x.rep, 0, y, dest.rep);
+  long z;
+  if (!x.rep && small_add(x.m_small, y, z))
+    dest.SetSmall(z);
+  else
+    dest.Assign(add(IntegerRepRef(x), 0, IntegerRepRef(y), 0, dest.rep));
 }
 
 void  sub(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = add(x.rep, 0, -y, dest.rep);
+  long z;
+  if (!x.rep && small_sub(x.m_small, y, z))
+    dest.SetSmall(z);
+  else
+    dest.Assign(add(IntegerRepRef(x), 0, IntegerRepRef(y), 1, dest.rep));
 }
 
 void  mul(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = multiply(x.rep, y, dest.rep);
+  long z;
+  if (!x.rep && small_mul(x.m_small, y, z))
+    dest.SetSmall(z);
+  else
+    dest.Assign(multiply(IntegerRepRef(x), IntegerRepRef(y), dest.rep));
 }
 
 void  div(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = div(x.rep, y, dest.rep);
+  if (!x.rep) {
+    if (y == 0)  throw Gambit::ZeroDivideException();
+    dest.SetSmall(x.m_small / y);
+  }
+  else
+    dest.Assign(div(x.rep, IntegerRepRef(y), dest.rep));
 }
 
 void  mod(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = mod(x.rep, y, dest.rep);
+  if (!x.rep) {
+    if (y == 0)  throw Gambit::ZeroDivideException();
+    dest.SetSmall(x.m_small % y);
+  }
+  else
+    dest.Assign(mod(x.rep, IntegerRepRef(y), dest.rep));
 }
 
 
 void  lshift(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = lshift(x.rep, y, dest.rep);
+  dest.Assign(lshift(IntegerRepRef(x), y, dest.rep));
 }
 
 void  rshift(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = lshift(x.rep, -y, dest.rep);
+  dest.Assign(lshift(IntegerRepRef(x), -y, dest.rep));
 }
 
 void  pow(const Integer& x, long y, Integer& dest)
 {
-  dest.rep = power(x.rep, y, dest.rep);
+  dest.Assign(power(IntegerRepRef(x), y, dest.rep));
 }
 
 void abs(const Integer& x, Integer& dest)
 {
-  dest.rep = abs(x.rep, dest.rep);
+  if (!x.rep)
+    dest.SetSmall(labs(x.m_small));
+  else
+    dest.Assign(abs(x.rep, dest.rep));
 }
 
 void negate(const Integer& x, Integer& dest)
 {
-  dest.rep = negate(x.rep, dest.rep);
+  if (!x.rep)
+    dest.SetSmall(-x.m_small);
+  else
+    dest.Assign(negate(x.rep, dest.rep));
 }
 
 void complement(const Integer& x, Integer& dest)
 {
-  dest.rep = Compl(x.rep, dest.rep);
+  dest.Assign(Compl(IntegerRepRef(x), dest.rep));
 }
 
 void  add(long x, const Integer& y, Integer& dest)
 {
-  dest.rep = add(y.rep, 0, x, dest.rep);
+  add(y, x, dest);
 }
 
 void  sub(long x, const Integer& y, Integer& dest)
 {
-  dest.rep = add(y.rep, 1, x, dest.rep);
+  long z;
+  if (!y.rep && small_sub(x, y.m_small, z))
+    dest.SetSmall(z);
+  else
+    dest.Assign(add(IntegerRepRef(x), 0, IntegerRepRef(y), 1, dest.rep));
 }
 
 void  mul(long x, const Integer& y, Integer& dest)
 {
-  dest.rep = multiply(y.rep, x, dest.rep);
+  mul(y, x, dest);
 }
 
 // operator versions
@@ -2698,29 +2849,32 @@ void Integer::negate()
 
 int sign(const Integer& x)
 {
+  if (!x.rep)  return (x.m_small > 0) ? 1 : ((x.m_small < 0) ? -1 : 0);
   return (x.rep->len == 0) ? 0 : ( (x.rep->sgn == 1) ? 1 : -1 );
 }
 
 int even(const Integer& y)
 {
+  if (!y.rep)  return !(y.m_small & 1);
   return y.rep->len == 0 || !(y.rep->s[0] & 1);
 }
 
 int odd(const Integer& y)
 {
+  if (!y.rep)  return (y.m_small & 1) != 0;
   return y.rep->len > 0 && (y.rep->s[0] & 1);
 }
 
 std::string Itoa(const Integer& y, int base, int width)
 {
-  return Itoa(y.rep, base, width);
+  return Itoa(IntegerRepRef(y), base, width);
 }
 
 
 
 long lg(const Integer& x) 
 {
-  return lg(x.rep);
+  return lg(IntegerRepRef(x));
 }
 
 // constructive operations 
@@ -2870,16 +3024,21 @@ Integer Integer::operator-(void) const
 
 Integer  atoI(const char* s, int base) 
 {
-  Integer r;
-  r.rep = atoIntegerRep(s, base);
-  return r;
+  return Integer(atoIntegerRep(s, base));
 }
 
 Integer  gcd(const Integer& x, const Integer& y)
 {
-  Integer r;
-  r.rep = gcd(x.rep, y.rep);
-  return r;
+  if (!x.rep && !y.rep) {
+    long a = labs(x.m_small), b = labs(y.m_small);
+    while (b != 0) {
+      long t = a % b;
+      a = b;
+      b = t;
+    }
+    return Integer(a);
+  }
+  return Integer(gcd(IntegerRepRef(x), IntegerRepRef(y)));
 }
 
 
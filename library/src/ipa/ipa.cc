@@ -20,6 +20,7 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <vector>
 #include "gambit/gambit.h"
 #include "gambit/nash/ipa.h"
 #include "gambit/gtracer/gtracer.h"
@@ -39,19 +40,11 @@ NashIPAStrategySolver::Solve(const Game &p_game) const
   return Solve(p_game, pert);
 }
   
-List<MixedStrategyProfile<double> >
-NashIPAStrategySolver::Solve(const Game &p_game,
-			     const Array<double> &p_pert) const
+shared_ptr<gnmgame>
+NashIPAStrategySolver::BuildRepresentation(const Game &p_game) const
 {
-  if (!p_game->IsPerfectRecall()) {
-    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
-  }
-
-  Gambit::shared_ptr<gnmgame> A;
-  List<MixedStrategyProfile<double> > solutions;
-  
-  if (p_game->IsAgg()){
-    A = new aggame(dynamic_cast<GameAggRep &>(*p_game));
+  if (p_game->IsAgg()) {
+    return new aggame(dynamic_cast<GameAggRep &>(*p_game));
   }
   else {
     int *actions = new int[p_game->NumPlayers()];
@@ -62,7 +55,7 @@ NashIPAStrategySolver::Solve(const Game &p_game,
     }
     cvector payoffs(veclength);
   
-    A = new nfgame(p_game->NumPlayers(), actions, payoffs);
+    shared_ptr<gnmgame> A = new nfgame(p_game->NumPlayers(), actions, payoffs);
   
     int *profile = new int[p_game->NumPlayers()];
     for (StrategyProfileIterator iter(p_game); !iter.AtEnd(); iter++) {
@@ -74,22 +67,29 @@ NashIPAStrategySolver::Solve(const Game &p_game,
 	A->setPurePayoff(pl-1, profile, (*iter)->GetPayoff(pl));
       }
     }
+    return A;
   }
+}
 
-  cvector g(A->getNumActions()); // perturbation ray
+List<MixedStrategyProfile<double> >
+NashIPAStrategySolver::Solve(const Game &p_game, gnmgame &A,
+			     const Array<double> &p_pert) const
+{
+  List<MixedStrategyProfile<double> > solutions;
+  cvector g(A.getNumActions()); // perturbation ray
   int numEq;
 
-  cvector ans(A->getNumActions());
-  cvector zh(A->getNumActions(),1.0);
+  cvector ans(A.getNumActions());
+  cvector zh(A.getNumActions(),1.0);
   do {
     const double ALPHA = 0.2;
     const double EQERR = 1e-6;
 
-    for (int i = 0; i < A->getNumActions(); i++) {
+    for (int i = 0; i < A.getNumActions(); i++) {
       g[i] = p_pert[i+1];
     }
     g /= g.norm(); // normalized
-    numEq = IPA(*A, g, zh, ALPHA, EQERR, ans);
+    numEq = IPA(A, g, zh, ALPHA, EQERR, ans);
   } while(numEq == 0);
 
   MixedStrategyProfile<double> eqm = p_game->NewMixedStrategyProfile(0.0);
@@ -101,6 +101,68 @@ NashIPAStrategySolver::Solve(const Game &p_game,
   return solutions;
 }
 
+List<MixedStrategyProfile<double> >
+NashIPAStrategySolver::Solve(const Game &p_game,
+			     const Array<double> &p_pert) const
+{
+  if (!p_game->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+  shared_ptr<gnmgame> A = BuildRepresentation(p_game);
+  return Solve(p_game, *A, p_pert);
+}
+
+//
+// As in NashGNMStrategySolver, the representation of a table game is
+// shared by all threads, while each thread traces an action-graph game
+// on a representation of its own copy of the game.
+//
+List<MixedStrategyProfile<double> >
+NashIPAStrategySolver::Solve(const Game &p_game,
+			     const List<MixedStrategyProfile<double> > &p_perts) const
+{
+  if (!p_game->IsPerfectRecall()) {
+    throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
+  }
+
+  std::vector<Array<double> > perts;
+  for (int k = 1; k <= p_perts.size(); k++) {
+    Array<double> pert(p_perts[k].MixedProfileLength());
+    for (int i = 1; i <= pert.Length(); i++) {
+      pert[i] = p_perts[k][i];
+    }
+    perts.push_back(pert);
+  }
+
+  shared_ptr<gnmgame> A;
+  if (!p_game->IsAgg()) {
+    A = BuildRepresentation(p_game);
+  }
+  ProfileSweep<double> sweep(p_game, perts.size(), m_tolerance, *m_onEquilibrium);
+
+#pragma omp parallel for schedule(dynamic, 1)
+  for (int k = 1; k <= (int) perts.size(); k++) {
+    try {
+      const Game &game = sweep.GetThreadGame();
+      NashIPAStrategySolver solver(sweep.GetRecorder(k));
+      if (A.get()) {
+	solver.Solve(game, *A, perts[k-1]);
+      }
+      else {
+	aggame rep(dynamic_cast<GameAggRep &>(*game));
+	solver.Solve(game, rep, perts[k-1]);
+      }
+    }
+    catch (std::runtime_error &e) {
+      sweep.Fail(e.what());
+    }
+    sweep.Finish(k);
+  }
+
+  sweep.CheckErrors();
+  return sweep.GetEquilibria();
+}
+
 }  // end namespace Gambit::Nash
 }  // end namespace Gambit
 
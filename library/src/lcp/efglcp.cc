@@ -24,32 +24,82 @@
 #include <cstdio>
 #include <unistd.h>
 #include <iostream>
+#include <map>
 #include "gambit/gambit.h"
+#include "gambit/gametree.h"
 #include "gambit/linalg/lemketab.h"
 #include "gambit/linalg/lhtab.h"
+#include "gambit/linalg/sparselemke.h"
 #include "gambit/nash/lcp.h"
 
 namespace Gambit {
 namespace Nash {
 
+namespace {
+
+//
+// Collects the entries of the sequence form tableau by column, for
+// constructing a SparseLemkeTableau.  Entries never set are zero.
+//
+template <class T> class SparseColumns {
+public:
+  SparseColumns(int p_numRows) : m_columns(p_numRows + 1) { }
+
+  T &operator()(int i, int j)  { return m_columns[j][i]; }
+  const std::vector<std::map<int, T> > &GetColumns(void) const
+    { return m_columns; }
+
+private:
+  std::vector<std::map<int, T> > m_columns;
+};
+
+}  // end anonymous namespace
+
 template <class T> class NashLcpBehaviorSolver<T>::Solution {
 public:
   int ns1, ns2, ni1, ni2;
   Rational maxpay;
   T eps;
+  const CompiledGameTree *m_tree;
   List<GameInfoset> isets1, isets2;
-  List<Gambit::linalg::BFS<T> > m_list;
+  // For each player's information sets, by number, the position in
+  // isets1 or isets2, and the sequence preceding those of its actions
+  Array<Array<int> > m_infosetIndex, m_sequenceOffset;
+  // The CBFS found so far, by the hashes of their bases
+  std::multimap<unsigned int, Gambit::linalg::BFS<T> > m_bases;
   List<MixedBehaviorProfile<T> > m_equilibria;
 
+  void IndexInfosets(const BehaviorSupportProfile &);
   bool AddBFS(const linalg::LemkeTableau<T> &);
 
   int EquilibriumCount(void) const { return m_equilibria.size(); }
 };
 
+template <class T> void
+NashLcpBehaviorSolver<T>::Solution::IndexInfosets(const BehaviorSupportProfile &p_support)
+{
+  m_tree = &dynamic_cast<GameTreeRep &>(*p_support.GetGame()).GetCompiledTree();
+  m_infosetIndex = Array<Array<int> >(2);
+  m_sequenceOffset = Array<Array<int> >(2);
+  for (int pl = 1; pl <= 2; pl++) {
+    List<GameInfoset> &isets = (pl == 1) ? isets1 : isets2;
+    int numInfosets = p_support.GetGame()->GetPlayer(pl)->NumInfosets();
+    m_infosetIndex[pl] = Array<int>(numInfosets);
+    m_sequenceOffset[pl] = Array<int>(numInfosets);
+    int offset = 1;
+    for (int i = 1; i <= isets.Length(); i++) {
+      int iset = isets[i]->GetNumber();
+      m_infosetIndex[pl][iset] = i;
+      m_sequenceOffset[pl][iset] = offset;
+      offset += p_support.NumActions(pl, iset);
+    }
+  }
+}
+
 template <class T> bool 
 NashLcpBehaviorSolver<T>::Solution::AddBFS(const linalg::LemkeTableau<T> &tableau)
 {
-  Gambit::linalg::BFS<T> cbfs;
+  Gambit::linalg::BFS<T> cbfs(tableau.MinCol(), tableau.MaxCol());
   Vector<T> v(tableau.MinRow(), tableau.MaxRow());
   tableau.BasisVector(v);
 
@@ -59,13 +109,15 @@ NashLcpBehaviorSolver<T>::Solution::AddBFS(const linalg::LemkeTableau<T> &tablea
     }
   }
 
-  if (!m_list.Contains(cbfs)) {
-    m_list.push_back(cbfs);
-    return true;
-  }
-  else {
-    return false;
+  typedef typename std::multimap<unsigned int, Gambit::linalg::BFS<T> >::const_iterator iterator;
+  std::pair<iterator, iterator> bucket = m_bases.equal_range(cbfs.Hash());
+  for (iterator basis = bucket.first; basis != bucket.second; ++basis) {
+    if (basis->second == cbfs) {
+      return false;
+    }
   }
+  m_bases.insert(std::make_pair(cbfs.Hash(), cbfs));
+  return true;
 }
 
 //
@@ -90,6 +142,7 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 
   solution.isets1 = p_support.ReachableInfosets(p_support.GetGame()->GetPlayer(1));
   solution.isets2 = p_support.ReachableInfosets(p_support.GetGame()->GetPlayer(2));
+  solution.IndexInfosets(p_support);
 
   int ntot;
   solution.ns1 = p_support.NumSequences(1);
@@ -99,11 +152,21 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
 
   ntot = solution.ns1+solution.ns2+solution.ni1+solution.ni2;
 
+  solution.maxpay = p_support.GetGame()->GetMaxPayoff() + Rational(1);
+
+  if (m_sparse) {
+    try {
+      SolveSparse(p_support, solution);
+    }
+    catch (std::runtime_error &e) {
+      std::cerr << "Error: " << e.what() << std::endl;
+    }
+    return solution.m_equilibria;
+  }
+
   Matrix<T> A(1,ntot,0,ntot);
   Vector<T> b(1,ntot);
 
-  solution.maxpay = p_support.GetGame()->GetMaxPayoff() + Rational(1);
-
   T prob = (T)1;
   for (i = A.MinRow(); i <= A.MaxRow(); i++) {
     b[i] = (T) 0;
@@ -112,7 +175,7 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
     }
   }
 
-  FillTableau(p_support, A, p_support.GetGame()->GetRoot(), prob, 1, 1, 0, 0,
+  FillTableau(p_support, A, 0, prob, 1, 1, 0, 0,
 	      solution);
   for (i = A.MinRow(); i <= A.MaxRow(); i++) { 
     A(i,0) = -(T) 1;
@@ -148,7 +211,7 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
       solution.AddBFS(tab);
       tab.BasisVector(sol);
       GetProfile(p_support, tab, 
-		 profile,sol,p_support.GetGame()->GetRoot(), 1, 1,
+		 profile,sol,0, 1, 1,
 		 solution);
       profile.UndefinedToCentroid();
       solution.m_equilibria.push_back(profile);
@@ -161,6 +224,50 @@ NashLcpBehaviorSolver<T>::Solve(const BehaviorSupportProfile &p_support) const
   return solution.m_equilibria;
 }
 
+//
+// Solves the sequence form held as a SparseLemkeTableau, so that the
+// tableau is never formed as a dense matrix.  As when m_stopAfter is 1,
+// only the path from the primary ray is followed.
+//
+template <class T> void
+NashLcpBehaviorSolver<T>::SolveSparse(const BehaviorSupportProfile &p_support,
+				      Solution &p_solution) const
+{
+  int ns1 = p_solution.ns1, ns2 = p_solution.ns2, ni1 = p_solution.ni1;
+  int ntot = ns1 + ns2 + ni1 + p_solution.ni2;
+
+  SparseColumns<T> A(ntot);
+  Vector<T> b(1, ntot);
+  b = (T) 0;
+
+  FillTableau(p_support, A, 0, (T) 1, 1, 1, 0, 0,
+	      p_solution);
+  for (int i = 1; i <= ntot; i++) {
+    A(i,0) = -(T) 1;
+  }
+  A(1,ns1+ns2+1) = (T) 1;
+  A(ns1+ns2+1,1) = -(T) 1;
+  A(ns1+1,ns1+ns2+ni1+1) = (T) 1;
+  A(ns1+ns2+ni1+1,ns1+1) = -(T) 1;
+  b[ns1+ns2+1] = -(T) 1;
+  b[ns1+ns2+ni1+1] = -(T) 1;
+
+  linalg::SparseLemkeTableau<T> tab(A.GetColumns(), b);
+  p_solution.eps = tab.Epsilon();
+
+  tab.Pivot(ns1+ns2+1, 0);
+  tab.SF_LCPPath(ns1+ns2+1);
+
+  MixedBehaviorProfile<T> profile(p_support);
+  Vector<T> sol(tab.MinRow(), tab.MaxRow());
+  tab.BasisVector(sol);
+  GetProfile(p_support, tab, profile, sol, 0,
+	     1, 1, p_solution);
+  profile.UndefinedToCentroid();
+  p_solution.m_equilibria.push_back(profile);
+  this->m_onEquilibrium->Render(profile);
+}
+
 
 //
 // All_Lemke finds all accessible Nash equilibria by recursively 
@@ -207,7 +314,7 @@ NashLcpBehaviorSolver<T>::AllLemke(const BehaviorSupportProfile &p_support,
       newsol = p_solution.AddBFS(BCopy);
       BCopy.BasisVector(sol);
       GetProfile(p_support, BCopy, profile, sol,
-		 p_support.GetGame()->GetRoot(), 1, 1,
+		 0, 1, 1,
 		 p_solution);
       profile.UndefinedToCentroid();
       if (newsol) {
@@ -230,10 +337,9 @@ NashLcpBehaviorSolver<T>::AllLemke(const BehaviorSupportProfile &p_support,
   }
 }
 
-template <class T>
+template <class T> template <class M>
 void NashLcpBehaviorSolver<T>::FillTableau(const BehaviorSupportProfile &p_support, 
-					Matrix<T> &A,
-					const GameNode &n, T prob,
+					M &A, int n, T prob,
 					int s1, int s2, int i1, int i2,
 					Solution &p_solution) const
 {
@@ -241,52 +347,44 @@ void NashLcpBehaviorSolver<T>::FillTableau(const BehaviorSupportProfile &p_suppo
   int ns1 = p_solution.ns1;
   int ns2 = p_solution.ns2;
   int ni1 = p_solution.ni1;
+  const CompiledGameTree &tree = *p_solution.m_tree;
 
-  GameOutcome outcome = n->GetOutcome();
-  if (outcome) {
+  if (tree.HasOutcome(n)) {
     A(s1,ns1+s2) = Rational(A(s1,ns1+s2)) +
-      Rational(prob) * (outcome->GetPayoff<Rational>(1) - p_solution.maxpay);
+      Rational(prob) * (tree.GetPayoff<Rational>(n, 1) - p_solution.maxpay);
     A(ns1+s2,s1) = Rational(A(ns1+s2,s1)) +
-      Rational(prob) * (outcome->GetPayoff<Rational>(2) - p_solution.maxpay);
+      Rational(prob) * (tree.GetPayoff<Rational>(n, 2) - p_solution.maxpay);
   }
-  if (n->GetInfoset()) {
-    if (n->GetPlayer()->IsChance()) {
-      GameInfoset infoset = n->GetInfoset();
-      for (int i = 1; i <= n->NumChildren(); i++) {
-	FillTableau(p_support, A, n->GetChild(i),
-		    Rational(prob) * infoset->GetActionProb(i, Rational(0)),
+  int infoset = tree.GetInfoset(n);
+  if (infoset >= 0) {
+    int pl = tree.GetPlayer(infoset), iset = tree.GetNumber(infoset);
+    if (pl == 0) {
+      for (int i = 1; i <= tree.NumChildren(n); i++) {
+	FillTableau(p_support, A, tree.GetChild(n, i),
+		    Rational(prob) * tree.GetActionProb<Rational>(infoset, i),
 		    s1, s2, i1, i2, p_solution);
       }
     }
-    int pl = n->GetPlayer()->GetNumber();
     if (pl==1) {
-      i1=p_solution.isets1.Find(n->GetInfoset());
-      snew=1;
-      for (int i = 1; i < i1; i++) {
-	snew+=p_support.NumActions(p_solution.isets1[i]->GetPlayer()->GetNumber(),
-				   p_solution.isets1[i]->GetNumber());
-      }
+      i1=p_solution.m_infosetIndex[1][iset];
+      snew=p_solution.m_sequenceOffset[1][iset];
       A(s1,ns1+ns2+i1+1) = -(T)1;
       A(ns1+ns2+i1+1,s1) = (T)1;
-      for (int i = 1; i <= p_support.NumActions(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber()); i++) {
+      for (int i = 1; i <= p_support.NumActions(pl, iset); i++) {
 	A(snew+i,ns1+ns2+i1+1) = (T)1;
 	A(ns1+ns2+i1+1,snew+i) = -(T)1;
-	FillTableau(p_support, A, n->GetChild(p_support.GetAction(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber(), i)->GetNumber()),prob,snew+i,s2,i1,i2, p_solution);
+	FillTableau(p_support, A, tree.GetChild(n, p_support.GetAction(pl, iset, i)->GetNumber()),prob,snew+i,s2,i1,i2, p_solution);
       }
     }
     if(pl==2) {
-      i2=p_solution.isets2.Find(n->GetInfoset());
-      snew=1;
-      for (int i = 1; i < i2; i++) {
-	snew+=p_support.NumActions(p_solution.isets2[i]->GetPlayer()->GetNumber(),
-				   p_solution.isets2[i]->GetNumber());
-      }
+      i2=p_solution.m_infosetIndex[2][iset];
+      snew=p_solution.m_sequenceOffset[2][iset];
       A(ns1+s2,ns1+ns2+ni1+i2+1) = -(T)1;
       A(ns1+ns2+ni1+i2+1,ns1+s2) = (T)1;
-      for (int i = 1; i <= p_support.NumActions(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber()); i++) {
+      for (int i = 1; i <= p_support.NumActions(pl, iset); i++) {
 	A(ns1+snew+i,ns1+ns2+ni1+i2+1) = (T)1;
 	A(ns1+ns2+ni1+i2+1,ns1+snew+i) = -(T)1;
-	FillTableau(p_support, A, n->GetChild(p_support.GetAction(n->GetInfoset()->GetPlayer()->GetNumber(), n->GetInfoset()->GetNumber(), i)->GetNumber()),prob,s1,snew+i,i1,i2, p_solution);
+	FillTableau(p_support, A, tree.GetChild(n, p_support.GetAction(pl, iset, i)->GetNumber()),prob,s1,snew+i,i1,i2, p_solution);
       }
     }
     
@@ -294,32 +392,31 @@ void NashLcpBehaviorSolver<T>::FillTableau(const BehaviorSupportProfile &p_suppo
 }
 
 
-template <class T> void
+template <class T> template <class Tableau> void
 NashLcpBehaviorSolver<T>::GetProfile(const BehaviorSupportProfile &p_support,
-				     const linalg::LemkeTableau<T> &tab, 
+				     const Tableau &tab, 
 				     MixedBehaviorProfile<T> &v, 
 				     const Vector<T> &sol,
-				     const GameNode &n, int s1, int s2,
+				     int n, int s1, int s2,
 				     Solution &p_solution) const
 {
   int ns1 = p_solution.ns1;
+  const CompiledGameTree &tree = *p_solution.m_tree;
+  int infoset = tree.GetInfoset(n);
 
-  if (n->GetInfoset()) {
-    int pl = n->GetPlayer()->GetNumber();
-    int iset = n->GetInfoset()->GetNumber();
+  if (infoset >= 0) {
+    int pl = tree.GetPlayer(infoset);
+    int iset = tree.GetNumber(infoset);
 
-    if (n->GetPlayer()->IsChance()) {
-      for (int i = 1; i <= n->NumChildren(); i++) {
-	GetProfile(p_support, tab, v, sol, n->GetChild(i), s1, s2,
+    if (pl == 0) {
+      for (int i = 1; i <= tree.NumChildren(n); i++) {
+	GetProfile(p_support, tab, v, sol, tree.GetChild(n, i), s1, s2,
 		   p_solution);
       }
     }
     else if (pl == 1) {
-      int inf = p_solution.isets1.Find(n->GetInfoset());
-      int snew = 1;
-      for (int i = 1; i < inf; i++) {
-	snew += p_support.NumActions(1, p_solution.isets1[i]->GetNumber()); 
-      }
+      int inf = p_solution.m_infosetIndex[1][iset];
+      int snew = p_solution.m_sequenceOffset[1][iset];
       
       for (int i = 1; i <= p_support.NumActions(pl, iset); i++) {
 	v(pl,inf,i) = (T) 0;
@@ -335,16 +432,13 @@ NashLcpBehaviorSolver<T>::GetProfile(const BehaviorSupportProfile &p_support,
 	  } 
 	} 
 	GetProfile(p_support, tab, v, sol,
-		   n->GetChild(p_support.GetAction(pl, iset, i)->GetNumber()),
+		   tree.GetChild(n, p_support.GetAction(pl, iset, i)->GetNumber()),
 		   snew+i, s2, p_solution);
       }
     }
     else if (pl == 2) { 
-      int inf = p_solution.isets2.Find(n->GetInfoset());
-      int snew = 1;
-      for (int i = 1; i < inf; i++) {
-	snew += p_support.NumActions(2, p_solution.isets2[i]->GetNumber()); 
-      }
+      int inf = p_solution.m_infosetIndex[2][iset];
+      int snew = p_solution.m_sequenceOffset[2][iset];
 
       for (int i = 1; i<= p_support.NumActions(pl, iset); i++) {
 	v(pl,inf,i) = (T) 0;
@@ -360,7 +454,7 @@ NashLcpBehaviorSolver<T>::GetProfile(const BehaviorSupportProfile &p_support,
 	  } 
 	} 
 	GetProfile(p_support, tab, v, sol,
-		   n->GetChild(p_support.GetAction(pl, iset, i)->GetNumber()),
+		   tree.GetChild(n, p_support.GetAction(pl, iset, i)->GetNumber()),
 		   s1, snew+i, p_solution);
       }
     }
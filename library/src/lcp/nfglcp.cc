@@ -23,6 +23,8 @@
 #include <cstdio>
 #include <unistd.h>
 #include <iostream>
+#include <set>
+#include <vector>
 
 #include "gambit/gambit.h"
 #include "gambit/linalg/lhtab.h"
@@ -112,26 +114,40 @@ template <class T> Vector<T> Make_b2(const Game &p_game)
   return b2;
 }
 
+//
+// Returns which of the variables are basic in the tableau.  This
+// identifies the CBFS, in the same sense as BFS::operator==, without
+// computing the values of the basic variables.
+//
+template <class T> std::vector<bool> GetBasis(const linalg::LHTableau<T> &p_tableau)
+{
+  std::vector<bool> basis(p_tableau.MaxCol() - p_tableau.MinCol() + 1);
+  for (int i = p_tableau.MinCol(); i <= p_tableau.MaxCol(); i++) {
+    basis[i - p_tableau.MinCol()] = p_tableau.Member(i);
+  }
+  return basis;
+}
+
 }  // end anonymous namespace
   
 
 template <class T>
 class NashLcpStrategySolver<T>::Solution {
 public:
-  List<Gambit::linalg::BFS<T> > m_bfsList;
+  std::set<std::vector<bool> > m_bases;
   List<MixedStrategyProfile<T> > m_equilibria;
 
-  bool Contains(const Gambit::linalg::BFS<T> &p_bfs) const
-  { return m_bfsList.Contains(p_bfs); }
-  void push_back(const Gambit::linalg::BFS<T> &p_bfs)
-  { m_bfsList.push_back(p_bfs); }
+  bool Contains(const std::vector<bool> &p_basis) const
+  { return m_bases.count(p_basis) > 0; }
+  void push_back(const std::vector<bool> &p_basis)
+  { m_bases.insert(p_basis); }
 
   int EquilibriumCount(void) const { return m_equilibria.size(); }
 };
   
 //
 // Function called when a CBFS is encountered.
-// If it is not already in the list p_list, it is added.
+// If it is not already in the set of bases visited, it is added.
 // The corresponding equilibrium is computed and output.
 // Returns 'true' if the CBFS is new; 'false' if it already appears in the
 // list.
@@ -141,12 +157,13 @@ NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
 				linalg::LHTableau<T> &p_tableau,
 				Solution &p_solution) const
 {
-  Gambit::linalg::BFS<T> cbfs(p_tableau.GetBFS());
-  if (p_solution.Contains(cbfs)) {
+  std::vector<bool> basis(GetBasis(p_tableau));
+  if (p_solution.Contains(basis)) {
     return false;
   }
-  p_solution.push_back(cbfs);
+  p_solution.push_back(basis);
 
+  Gambit::linalg::BFS<T> cbfs(p_tableau.GetBFS());
   MixedStrategyProfile<T> profile(p_game->NewMixedStrategyProfile(static_cast<T>(0.0)));
   int n1 = p_game->Players()[1]->Strategies().size();
   int n2 = p_game->Players()[2]->Strategies().size();
@@ -197,10 +214,19 @@ NashLcpStrategySolver<T>::OnBFS(const Game &p_game,
 
 //
 // AllLemke finds all accessible Nash equilibria by recursively 
-// calling itself.  p_list maintains the list of basic variables 
+// calling itself.  p_solution maintains the set of bases
 // for the equilibria that have already been found.  
 // From each new accessible equilibrium, it follows
-// all possible paths, adding any new equilibria to the List.  
+// all possible paths, adding any new equilibria to the set.  
+//
+// The paths leaving a CBFS do not depend on each other, and are
+// followed in parallel to find the CBFS at the end of each.  The new
+// ones among these are then visited in the order of the paths leading
+// to them, exactly as if the paths were followed one after another,
+// so equilibria are found in the same order whatever the number of
+// threads.  The tableaux at the ends of the paths are not kept, as the
+// recursion may be deep; a path leading to a CBFS not yet visited
+// is followed again to visit it.
 //
 template <class T> void 
 NashLcpStrategySolver<T>::AllLemke(const Game &p_game,
@@ -218,8 +244,29 @@ NashLcpStrategySolver<T>::AllLemke(const Game &p_game,
     return;
   }
   
+  // Following a path would only lead past the maximum depth
+  if (m_maxDepth != 0 && depth + 1 > m_maxDepth) {
+    return;
+  }
+
+  // An empty entry marks a path which could not be followed here; it is
+  // followed again below, where its error is reported as usual.
+  std::vector<std::vector<bool> > ends(B.MaxCol() - B.MinCol() + 1);
+#pragma omp parallel for schedule(dynamic, 1)
   for (int i = B.MinCol(); i <= B.MaxCol(); i++) {
     if (i != j)  {
+      try {
+	linalg::LHTableau<T> Bcopy(B);
+	Bcopy.LemkePath(i);
+	ends[i - B.MinCol()] = GetBasis(Bcopy);
+      }
+      catch (...) { }
+    }
+  }
+
+  for (int i = B.MinCol(); i <= B.MaxCol(); i++) {
+    const std::vector<bool> &end = ends[i - B.MinCol()];
+    if (i != j && (end.empty() || !p_solution.Contains(end)))  {
       linalg::LHTableau<T> Bcopy(B);
       Bcopy.LemkePath(i);
       AllLemke(p_game, i, Bcopy, p_solution, depth+1);
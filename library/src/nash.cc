@@ -20,6 +20,12 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <algorithm>
+#include <cmath>
+#ifdef _OPENMP
+#include <omp.h>
+#endif  // _OPENMP
+
 #include "gambit/nash.h"
 
 namespace Gambit {
@@ -181,6 +187,138 @@ template class BehavStrategyDetailRenderer<Rational>;
 
 
 
+//------------------------------------------------------------------------
+//                         class ProfileSweep
+//------------------------------------------------------------------------
+
+template <class T>
+class ProfileSweep<T>::Recorder : public StrategyProfileRenderer<T> {
+public:
+  Recorder(std::vector<Record> &p_records) : m_records(p_records) { }
+  virtual ~Recorder() { }
+  virtual void Render(const MixedStrategyProfile<T> &p_profile,
+		      const std::string &p_label = "NE") const
+  { m_records.push_back(Record(p_label, false, p_profile)); }
+  virtual void Render(const MixedBehaviorProfile<T> &p_profile,
+		      const std::string &p_label = "NE") const
+  { m_records.push_back(Record(p_label, true, p_profile)); }
+
+private:
+  std::vector<Record> &m_records;
+};
+
+template <class T>
+ProfileSweep<T>::ProfileSweep(const Game &p_game, int p_numRuns,
+			      double p_tolerance,
+			      const StrategyProfileRenderer<T> &p_renderer)
+  : m_game(p_game), m_threadGames(NumThreads()), m_tolerance(p_tolerance),
+    m_renderer(p_renderer), m_records(p_numRuns), m_done(p_numRuns, false),
+    m_next(0)
+{
+  for (size_t t = 0; t < m_threadGames.size(); t++) {
+    m_threadGames[t] = p_game->Copy();
+  }
+}
+
+template <class T> int ProfileSweep<T>::NumThreads(void)
+{
+#ifdef _OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif  // _OPENMP
+}
+
+template <class T> const Game &ProfileSweep<T>::GetThreadGame(void) const
+{
+#ifdef _OPENMP
+  return m_threadGames[omp_get_thread_num()];
+#else
+  return m_threadGames[0];
+#endif  // _OPENMP
+}
+
+template <class T> shared_ptr<StrategyProfileRenderer<T> >
+ProfileSweep<T>::GetRecorder(int p_run)
+{
+  return new Recorder(m_records[p_run - 1]);
+}
+
+template <class T>
+bool ProfileSweep<T>::IsDuplicate(const Vector<T> &p_probs) const
+{
+  for (int i = 1; i <= m_found.size(); i++) {
+    if (m_found[i].Length() != p_probs.Length()) continue;
+    double distance = 0.0;
+    for (int j = 1; j <= p_probs.Length(); j++) {
+      distance = std::max(distance, std::fabs((double) (m_found[i][j] - p_probs[j])));
+    }
+    if (distance < m_tolerance) {
+      return true;
+    }
+  }
+  return false;
+}
+
+template <class T> void ProfileSweep<T>::Replay(const Record &p_record)
+{
+  bool isEquilibrium = (p_record.m_label == "NE");
+  if (isEquilibrium) {
+    if (IsDuplicate(p_record.m_probs)) {
+      return;
+    }
+    m_found.push_back(p_record.m_probs);
+  }
+  if (p_record.m_isBehav) {
+    MixedBehaviorProfile<T> profile(m_game);
+    profile = p_record.m_probs;
+    m_renderer.Render(profile, p_record.m_label);
+    if (isEquilibrium) {
+      m_behavEquilibria.push_back(profile);
+    }
+  }
+  else {
+    MixedStrategyProfile<T> profile(m_game->NewMixedStrategyProfile(T(0)));
+    static_cast<Vector<T> &>(profile) = p_record.m_probs;
+    m_renderer.Render(profile, p_record.m_label);
+    if (isEquilibrium) {
+      m_strategyEquilibria.push_back(profile);
+    }
+  }
+}
+
+template <class T> void ProfileSweep<T>::Finish(int p_run)
+{
+#pragma omp critical(profile_sweep)
+  {
+    m_done[p_run - 1] = true;
+    for (; m_next < (int) m_done.size() && m_done[m_next]; m_next++) {
+      for (size_t i = 0; i < m_records[m_next].size(); i++) {
+	Replay(m_records[m_next][i]);
+      }
+      m_records[m_next].clear();
+    }
+  }
+}
+
+template <class T> void ProfileSweep<T>::Fail(const std::string &p_message)
+{
+#pragma omp critical(profile_sweep)
+  if (m_error == "") {
+    m_error = p_message;
+  }
+}
+
+template <class T> void ProfileSweep<T>::CheckErrors(void) const
+{
+  if (m_error != "") {
+    throw std::runtime_error(m_error);
+  }
+}
+
+template class ProfileSweep<double>;
+template class ProfileSweep<Rational>;
+
 template <class T>
 StrategySolver<T>::StrategySolver(shared_ptr<StrategyProfileRenderer<T> > p_onEquilibrium /* = 0 */)
   : m_onEquilibrium(p_onEquilibrium)
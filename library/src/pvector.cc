@@ -25,5 +25,6 @@
 
 template class Gambit::PVector<int>;
 template class Gambit::PVector<double>;
+template class Gambit::PVector<Gambit::Integer>;
 template class Gambit::PVector<Gambit::Rational>;
 
@@ -390,15 +390,12 @@ Rational::fits_in_double() const
 // These were moved from the header file to eliminate warnings
 //
 
-static IntegerRep _ZeroRep = {1, 0, 1, {0}};
-static IntegerRep _OneRep = {1, 0, 1, {1}};
-
-Rational::Rational() : num(&_ZeroRep), den(&_OneRep) {}
+Rational::Rational() : num(0L), den(1L) {}
 Rational::~Rational() {}
 
 Rational::Rational(const Rational& y) :num(y.num), den(y.den) {}
 
-Rational::Rational(const Integer& n) :num(n), den(&_OneRep) {}
+Rational::Rational(const Integer& n) :num(n), den(1L) {}
 
 Rational::Rational(const Integer& n, const Integer& d) 
  : num(n), den(d)
@@ -409,9 +406,9 @@ Rational::Rational(const Integer& n, const Integer& d)
   normalize();
 }
 
-Rational::Rational(long n) :num(n), den(&_OneRep) { }
+Rational::Rational(long n) :num(n), den(1L) { }
 
-Rational::Rational(int n) :num(n), den(&_OneRep) { }
+Rational::Rational(int n) :num(n), den(1L) { }
 
 Rational::Rational(long n, long d) 
  : num(n), den(d)
@@ -537,9 +534,50 @@ Rational Rational::operator/(const Rational &y) const
 }
 
 
+//
+// Numbers in savefiles are nearly always integers, fractions, or decimals
+// short enough to be accumulated in a long; these are converted
+// directly.  Returns false if the text is not of this form.
+//
+static bool ParseSmallRational(const std::string &f, Rational &p_value)
+{
+  const char *c = f.c_str();
+  bool negative = (*c == '-');
+  if (negative)  c++;
+
+  long num = 0, denom = 1;
+  int digits = 0;
+  for (; *c >= '0' && *c <= '9'; c++, digits++) {
+    num = num * 10 + (*c - '0');
+  }
+  if (*c == '/') {
+    denom = 0;
+    for (c++; *c >= '0' && *c <= '9'; c++, digits++) {
+      denom = denom * 10 + (*c - '0');
+    }
+  }
+  else if (*c == '.') {
+    for (c++; *c >= '0' && *c <= '9'; c++, digits++) {
+      num = num * 10 + (*c - '0');
+      denom *= 10;
+    }
+  }
+  // Eighteen decimal digits always fit in a (64-bit) long
+  if (*c != '\0' || digits > 18 || sizeof(long) < 8) {
+    return false;
+  }
+  p_value = Rational((negative) ? -num : num, denom);
+  return true;
+}
+
 template<>
 Rational lexical_cast(const std::string &f)
 {
+  Rational value;
+  if (ParseSmallRational(f, value)) {
+    return value;
+  }
+
   char ch = ' ';
   int sign = 1;
   unsigned int index = 0, length = f.length();
@@ -20,58 +20,140 @@
 // Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
 //
 
+#include <algorithm>
 #include "gambit/gambit.h"
+#include "gambit/gametable.h"
 #include "gambit/nash/simpdiv.h"
 
 namespace Gambit {
 namespace Nash {
 
 //-------------------------------------------------------------------------
-//          NashSimpdivStrategySolver: Private member functions
+//                      class SimpdivCheckpoint
 //-------------------------------------------------------------------------
 
-inline GameStrategy GetStrategy(const Game &game, int pl, int st)
+inline Integer find_lcd(const Vector<Rational> &vec)
 {
-  return game->Players()[pl]->Strategies()[st];
+  Integer lcd(1);
+  for (int i = vec.First(); i <= vec.Last(); i++) {
+    lcd = lcm(vec[i].denominator(), lcd);
+  }
+  return lcd;
 }
 
+//
+// Before any level is searched, the grid is the coarsest one on which
+// the starting point lies.
+//
+SimpdivCheckpoint::SimpdivCheckpoint(const MixedStrategyProfile<Rational> &p_start)
+  : m_probs(static_cast<const Vector<Rational> &>(p_start)),
+    m_grid(Rational(1, find_lcd(static_cast<const Vector<Rational> &>(p_start)))),
+    m_levels(0), m_finished(false)
+{ }
+
+MixedStrategyProfile<Rational> 
+SimpdivCheckpoint::GetProfile(const Game &p_game) const
+{
+  if (m_probs.Length() != p_game->MixedProfileLength()) {
+    throw DimensionException();
+  }
+  MixedStrategyProfile<Rational> profile(p_game->NewMixedStrategyProfile(Rational(0)));
+  for (int i = 1; i <= m_probs.Length(); i++) {
+    profile[i] = m_probs[i];
+  }
+  return profile;
+}
+
+//
+// The line holds the number of levels searched, whether the run is
+// finished (0 or 1), the grid spacing, the number of probabilities,
+// and the probabilities, separated by spaces.
+//
+void SimpdivCheckpoint::Write(std::ostream &p_stream) const
+{
+  p_stream << m_levels << ' ' << ((m_finished) ? 1 : 0) << ' ' << m_grid;
+  p_stream << ' ' << m_probs.Length();
+  for (int i = 1; i <= m_probs.Length(); i++) {
+    p_stream << ' ' << m_probs[i];
+  }
+  p_stream << std::endl;
+}
+
+void SimpdivCheckpoint::Read(std::istream &p_stream)
+{
+  int finished, length;
+  if (!(p_stream >> m_levels >> finished) || m_levels < 0 || 
+      (finished != 0 && finished != 1)) {
+    throw InvalidFileException("Checkpoint not in a recognized format");
+  }
+  try {
+    p_stream >> m_grid;
+    if (!(p_stream >> length) || length < 0 || m_grid <= Rational(0)) {
+      throw InvalidFileException("Checkpoint not in a recognized format");
+    }
+    m_probs = Array<Rational>(length);
+    for (int i = 1; i <= length; i++) {
+      p_stream >> m_probs[i];
+    }
+  }
+  catch (ValueException &) {
+    throw InvalidFileException("Checkpoint not in a recognized format");
+  }
+  m_finished = (finished == 1);
+}
+
+//-------------------------------------------------------------------------
+//          NashSimpdivStrategySolver: Private member functions
+//-------------------------------------------------------------------------
+
+//
+// The search is carried out on the integer coordinates of the grid
+// points, which are the probabilities multiplied by the denominator 1/d.
+// The starting point lies on the grid, since d divides the denominators
+// of its probabilities.
+//
 Rational 
-NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
+NashSimpdivStrategySolver::Simplex(State &state,
+				   MixedStrategyProfile<Rational> &p_profile,
 				   const Rational &d) const
 {
-  Game game = y.GetGame();
-  State state;
-  state.d = d;
+  Game game = p_profile.GetGame();
+  Integer denom = d.denominator();
+  state.Reset(denom);
   Array<int> nstrats(game->NumStrategies());
   Array<int> ylabel(2);
-  RectArray<int> labels(y.MixedProfileLength(), 2), pi(y.MixedProfileLength(), 2);
-  PVector<int> U(nstrats), TT(nstrats);
-  PVector<Rational> ab(nstrats), besty(nstrats), v(nstrats);
-  for (int i = 1; i <= v.Length(); i++) {
-    v[i] = y[i];
+  RectArray<int> labels(p_profile.MixedProfileLength(), 2);
+  RectArray<int> pi(p_profile.MixedProfileLength(), 2);
+  PVector<int> U(nstrats), TT(nstrats), ab(nstrats);
+  PVector<Integer> y(nstrats), besty(nstrats), v(nstrats);
+  for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+    GamePlayer player = game->GetPlayer(pl);
+    for (int st = 1; st <= nstrats[pl]; st++) {
+      v(pl,st) = (p_profile[player->GetStrategy(st)] * Rational(denom)).numerator();
+    }
   }
-  besty = static_cast<Vector<Rational> &>(y);
+  besty = v;
   int i = 0;
   int j, k, h, jj, hh,ii, kk,tot;
-  Rational maxz;
 
 // Label step0 not currently used, hence commented
 // step0:
   TT = 0;
   U = 0;
-  ab = Rational(0);
+  ab = 0;
   for (j = 1; j <= game->NumPlayers(); j++)  {
-    GamePlayer player = game->Players()[j];
     for (h = 1; h <= nstrats[j]; h++)  {
-      if (v(j,h) == Rational(0)) {
+      if (v(j,h) == 0L) {
 	U(j,h) = 1;
       }
-      y[player->Strategies()[h]] = v(j,h);
     }
   }
+  y = v;
 
  step1:
-  maxz = state.getlabel(y, ylabel, besty);
+  if (state.getlabel(y, ylabel)) {
+    besty = y;
+  }
   j = ylabel[1];
   h = ylabel[2];
   labels(state.ibar,1) = j;
@@ -156,9 +238,7 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   getY(state, y, v, U, TT, ab, pi, ii);
   
   /* case3a */
-  if (i==1 && 
-      (y[GetStrategy(game, j, k)]<=Rational(0) || 
-       (v(j,k)-y[GetStrategy(game, j, k)]) >= Rational(m_leashLength)*state.d)) {
+  if (i==1 && (y(j,k) <= 0L || v(j,k) - y(j,k) >= (long) m_leashLength)) {
     for (hh = 1, tot = 0; hh <= nstrats[j]; hh++) {
       if (TT(j,hh)==1 || U(j,hh)==1)  {
 	tot++;
@@ -177,19 +257,17 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   }
   /* case3b */
   else if (i>=2 && i<=state.t &&
-	   (y[GetStrategy(game, j, k)] <= Rational(0) || 
-	    (v(j,k)-y[GetStrategy(game, j, k)]) >= Rational(m_leashLength)*state.d)) {
+	   (y(j,k) <= 0L || v(j,k) - y(j,k) >= (long) m_leashLength)) {
     goto step4;
   }
   /* case3c */
-  else if (i==state.t+1 && ab(j,kk) == Rational(0)) {
-    if (y[GetStrategy(game, j, h)] <= Rational(0) || 
-	(v(j,h)-y[GetStrategy(game, j, h)]) >= Rational(m_leashLength)*state.d) {
+  else if (i==state.t+1 && ab(j,kk) == 0) {
+    if (y(j,h) <= 0L || v(j,h) - y(j,h) >= (long) m_leashLength) {
       goto step4;
     }
     else {
       k=0;
-      while (ab(j,kk) == Rational(0) && k==0) {
+      while (ab(j,kk) == 0 && k==0) {
 	if(kk==h)k=1;
 	kk++;
 	if (kk > nstrats[j]) {
@@ -219,8 +297,8 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
       j = pi(state.t,1);
       h = pi(state.t,2);
       hh = get_b(j,h,nstrats[j],U);
-      y[GetStrategy(game, j, h)] -= state.d;
-      y[GetStrategy(game, j, hh)] += state.d;
+      --y(j,h);
+      ++y(j,hh);
     }
     update(state, pi, labels, ab, U, j, i);
   }
@@ -231,8 +309,7 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   j = pi(i-1,1);
   h = pi(i-1,2);
   TT(j,h) = 0;
-  if (y[GetStrategy(game, j, h)] <= Rational(0) || 
-      (v(j,h)-y[GetStrategy(game, j, h)]) >= Rational(m_leashLength)*state.d) {
+  if (y(j,h) <= 0L || v(j,h) - y(j,h) >= (long) m_leashLength) {
     U(j,h) = 1;
   }
   labels.RotateUp(i,state.t+1);
@@ -254,8 +331,8 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   jj=pi(1,1);
   hh=pi(1,2);
   kk=get_b(jj,hh,nstrats[jj],U);
-  y[GetStrategy(game, jj, hh)] -= state.d;
-  y[GetStrategy(game, jj, kk)] += state.d;
+  --y(jj,hh);
+  ++y(jj,kk);
   
   k = get_c(j,h,nstrats[j],U);
   kk=1;
@@ -263,7 +340,7 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
     if (k == h) {
       kk = 0;
     }
-    ab(j,k) -= Rational(1);
+    ab(j,k)--;
     k++;
     if (k > nstrats[j]) {
       k = 1;
@@ -272,19 +349,18 @@ NashSimpdivStrategySolver::Simplex(MixedStrategyProfile<Rational> &y,
   goto step1;
 
  end:
-  maxz=state.bestz;
   for (i = 1; i <= game->NumPlayers(); i++) {
     for (j = 1; j <= nstrats[i]; j++) {
-      y[GetStrategy(game, i, j)] = besty(i,j);
+      p_profile[game->GetPlayer(i)->GetStrategy(j)] = Rational(besty(i,j), denom);
     }
   }
-  return maxz;
+  return state.GetBestRegret();
 }
 
 void NashSimpdivStrategySolver::update(State &state,
 				       RectArray<int> &pi,
 				       RectArray<int> &labels,
-				       PVector<Rational> &ab,
+				       PVector<int> &ab,
 				       const PVector<int> &U,
 				       int j, int i) const
 {
@@ -304,7 +380,7 @@ void NashSimpdivStrategySolver::update(State &state,
       k=get_c(jj,hh,ab.Lengths()[jj],U);
       while(f) {
 	if(k==hh)f=0;
-	ab(j,k) += Rational(1);
+	ab(j,k)++;
 	k++;
 	if(k>ab.Lengths()[jj])k=1;
       }
@@ -320,7 +396,7 @@ void NashSimpdivStrategySolver::update(State &state,
       k=get_c(jj,hh,ab.Lengths()[jj],U);
       while(f) {
 	if(k==hh)f=0;
-	ab(j,k) -= Rational(1);
+	ab(j,k)--;
 	k++;
 	if(k>ab.Lengths()[jj])k=1;
       }
@@ -330,22 +406,22 @@ void NashSimpdivStrategySolver::update(State &state,
 }
 
 void NashSimpdivStrategySolver::getY(State &state,
-				     MixedStrategyProfile<Rational> &x,
-				     PVector<Rational> &v, 
+				     PVector<Integer> &x,
+				     const PVector<Integer> &v, 
 				     const PVector<int> &U,
 				     const PVector<int> &TT,
-				     const PVector<Rational> &ab,
+				     const PVector<int> &ab,
 				     const RectArray<int> &pi,
 				     int k) const
 {
-  static_cast<Vector<Rational> & >(x) = v;
-  for (int j = 1; j <= x.GetGame()->Players().size(); j++) {
-    GamePlayer player = x.GetGame()->Players()[j];
-    for (int h = 1; h <= player->Strategies().size(); h++) {
+  x = v;
+  for (int j = 1; j <= ab.Lengths().Length(); j++) {
+    int nstrats = ab.Lengths()[j];
+    for (int h = 1; h <= nstrats; h++) {
       if (TT(j,h) == 1 || U(j,h) == 1) {
-	x[player->Strategies()[h]] += state.d*ab(j,h);
-	int hh = (h > 1) ? h-1 : player->Strategies().size();
-	x[player->Strategies()[hh]] -= state.d*ab(j,h);
+	x(j,h) += (long) ab(j,h);
+	int hh = (h > 1) ? h-1 : nstrats;
+	x(j,hh) -= (long) ab(j,h);
       }
     }
   }
@@ -355,17 +431,16 @@ void NashSimpdivStrategySolver::getY(State &state,
 }
 
 void NashSimpdivStrategySolver::getnexty(State &state,
-					 MixedStrategyProfile<Rational> &x,
+					 PVector<Integer> &x,
 					 const RectArray<int> &pi, 
 					 const PVector<int> &U,
 					 int i) const
 {
   int j = pi(i,1);
-  GamePlayer player = x.GetGame()->Players()[j];
   int h = pi(i,2);
-  x[player->Strategies()[h]] += state.d;
-  int hh = get_b(j, h, player->Strategies().size(), U);
-  x[player->Strategies()[hh]] -= state.d;
+  ++x(j,h);
+  int hh = get_b(j, h, x.Lengths()[j], U);
+  --x(j,hh);
 }
 
 int NashSimpdivStrategySolver::get_b(int j, int h, int nstrats, const PVector<int> &U) const
@@ -387,91 +462,333 @@ int NashSimpdivStrategySolver::get_c(int j, int h, int nstrats,
   return (hh > nstrats) ? 1 : hh;
 }
 
-Rational 
-NashSimpdivStrategySolver::State::getlabel(MixedStrategyProfile<Rational> &yy,
-					   Array<int> &ylabel,
-					   PVector<Rational> &besty)
+//-------------------------------------------------------------------------
+//             NashSimpdivStrategySolver::State: Labeling
+//-------------------------------------------------------------------------
+
+NashSimpdivStrategySolver::State::State(const Game &p_game)
+  : t(0), ibar(1), m_game(p_game), m_haveBest(false),
+    m_isTable(dynamic_cast<GameTableRep *>(p_game.operator->()) != 0),
+    m_numStrats(p_game->NumStrategies()), m_lcd(1),
+    m_vertex(m_numStrats), m_values(m_numStrats), m_valuesValid(false),
+    m_profile(p_game->NewMixedStrategyProfile(Rational(0)))
 {
-  Rational maxz = -1000000;
-  ylabel[1] = 1;
-  ylabel[2] = 1;
-  
-  for (int i = 1; i <= yy.GetGame()->NumPlayers(); i++) {
-    GamePlayer player = yy.GetGame()->Players()[i];
+  if (!m_isTable) return;
+
+  // The payoffs are scaled by the lcd of their denominators, so that
+  // the values of strategies at vertices are integers.
+  const GameTableRep &game = dynamic_cast<GameTableRep &>(*p_game);
+  long ncont = game.NumStrategyContingencies();
+  for (int pl = 1; pl <= game.NumPlayers(); pl++) {
+    const Rational *payoffs = game.GetPayoffTable<Rational>(pl);
+    for (long cont = 0; cont < ncont; cont++) {
+      m_lcd = lcm(payoffs[cont].denominator(), m_lcd);
+    }
+  }
+  m_payoffs = Array<std::vector<Integer> >(game.NumPlayers());
+  m_strides = Array<long>(game.NumPlayers());
+  long stride = 1;
+  for (int pl = 1; pl <= game.NumPlayers(); pl++) {
+    const Rational *payoffs = game.GetPayoffTable<Rational>(pl);
+    m_payoffs[pl].resize(ncont);
+    for (long cont = 0; cont < ncont; cont++) {
+      m_payoffs[pl][cont] = (payoffs[cont] * Rational(m_lcd)).numerator();
+    }
+    m_strides[pl] = stride;
+    stride *= m_numStrats[pl];
+  }
+}
+
+void NashSimpdivStrategySolver::State::Reset(const Integer &p_denom)
+{
+  t = 0;
+  ibar = 1;
+  m_denom = p_denom;
+  m_haveBest = false;
+  m_valuesValid = false;
+}
+
+//
+// Sums the payoffs to player pl over the strategies of all other players,
+// weighted by their coordinates at the current vertex, except that the
+// player p_first (if nonzero) is weighted by p_weights instead.  The
+// result has one entry for each strategy of pl.
+//
+// Contingencies are numbered with the first player's strategy varying
+// fastest.  The player p_first is summed over first, after which the
+// others are summed over from the last to the first, so that the stride
+// of each in the partially summed table is its original stride, divided
+// by the number of strategies of p_first if that comes before it.
+//
+void NashSimpdivStrategySolver::State::Contract(int pl, int p_first,
+						const Integer *p_weights,
+						std::vector<Integer> &p_result)
+{
+  const Integer *src = &m_payoffs[pl][0];
+  long size = m_payoffs[pl].size();
+  bool toFirst = true;
+  Integer term;
+  for (int step = 0; step <= m_numStrats.Length(); step++) {
+    int opp = (step == 0) ? p_first : m_numStrats.Length() + 1 - step;
+    if (opp == 0 || opp == pl || (step > 0 && opp == p_first)) continue;
+    const Integer *weights = (step == 0) ? p_weights : &m_vertex(opp, 1);
+    long stride = m_strides[opp];
+    if (p_first != 0 && p_first < opp) {
+      stride /= m_numStrats[p_first];
+    }
+    int num = m_numStrats[opp];
+    long outer = size / (stride * num);
+
+    std::vector<Integer> &dest = (toFirst) ? m_work1 : m_work2;
+    toFirst = !toFirst;
+    if ((long) dest.size() < stride * outer) {
+      dest.resize(stride * outer);
+    }
+    for (long i = 0; i < stride * outer; i++) {
+      dest[i] = 0L;
+    }
+    for (int s = 0; s < num; s++) {
+      if (weights[s] == 0L) continue;
+      for (long hi = 0; hi < outer; hi++) {
+	const Integer *in = src + (hi * num + s) * stride;
+	Integer *out = &dest[hi * stride];
+	for (long lo = 0; lo < stride; lo++) {
+	  if (in[lo] == 0L) continue;
+	  mul(in[lo], weights[s], term);
+	  out[lo] += term;
+	}
+      }
+    }
+    src = &dest[0];
+    size = stride * outer;
+  }
+  p_result.resize(size);
+  std::copy(src, src + size, p_result.begin());
+}
+
+void 
+NashSimpdivStrategySolver::State::ComputeValues(const PVector<Integer> &p_vertex)
+{
+  m_vertex = p_vertex;
+  std::vector<Integer> values;
+  for (int pl = 1; pl <= m_numStrats.Length(); pl++) {
+    Contract(pl, 0, 0, values);
+    for (int st = 1; st <= m_numStrats[pl]; st++) {
+      m_values(pl, st) = values[st-1];
+    }
+  }
+  m_valuesValid = true;
+}
+
+//
+// The value of a strategy is linear in the coordinates of each other
+// player.  So, when the coordinates of a player change, the values of
+// the strategies of the others change by the sums of payoffs weighted by
+// the differences in that player's coordinates, and the current
+// coordinates of the rest.  Players whose coordinates changed are
+// taken in turn.  Successive vertices usually differ in two coordinates
+// of one player, and then this costs a fraction of recomputing the values.
+//
+void 
+NashSimpdivStrategySolver::State::UpdateValues(const PVector<Integer> &p_vertex)
+{
+  int numPlayers = m_numStrats.Length();
+  double cost = 0.0, fullCost = numPlayers;
+  for (int pl = 1; pl <= numPlayers; pl++) {
+    int changed = 0;
+    for (int st = 1; st <= m_numStrats[pl]; st++) {
+      if (p_vertex(pl, st) != m_vertex(pl, st)) changed++;
+    }
+    cost += (double) (numPlayers - 1) * changed / m_numStrats[pl];
+  }
+  if (cost >= fullCost) {
+    ComputeValues(p_vertex);
+    return;
+  }
+
+  std::vector<Integer> values;
+  for (int pl = 1; pl <= numPlayers; pl++) {
+    m_delta.resize(m_numStrats[pl]);
+    bool changed = false;
+    for (int st = 1; st <= m_numStrats[pl]; st++) {
+      m_delta[st-1] = p_vertex(pl, st) - m_vertex(pl, st);
+      if (m_delta[st-1] != 0L) changed = true;
+    }
+    if (!changed) continue;
+    for (int opp = 1; opp <= numPlayers; opp++) {
+      if (opp == pl) continue;
+      Contract(opp, pl, &m_delta[0], values);
+      for (int st = 1; st <= m_numStrats[opp]; st++) {
+	m_values(opp, st) += values[st-1];
+      }
+    }
+    for (int st = 1; st <= m_numStrats[pl]; st++) {
+      m_vertex(pl, st) = p_vertex(pl, st);
+    }
+  }
+}
+
+//
+// A vertex is labeled by the player with the largest regret, and that
+// player's best response, taking the first in case of ties.  With the
+// values of strategies w scaled as above, the regret of a player,
+// scaled by the denominator, is denom * max_j w_j - sum_j y_j w_j.
+//
+bool 
+NashSimpdivStrategySolver::State::TableLabel(const PVector<Integer> &y,
+					     Array<int> &ylabel)
+{
+  if (m_valuesValid) {
+    UpdateValues(y);
+  }
+  else {
+    ComputeValues(y);
+  }
+
+  Integer maxz, regret, term;
+  for (int i = 1; i <= m_numStrats.Length(); i++) {
+    int jj = 1;
+    Integer payoff = 0;
+    for (int j = 1; j <= m_numStrats[i]; j++) {
+      if (m_values(i, j) > m_values(i, jj)) {
+	jj = j;
+      }
+      mul(y(i, j), m_values(i, j), term);
+      payoff += term;
+    }
+    mul(m_denom, m_values(i, jj), regret);
+    regret -= payoff;
+    if (i == 1 || regret > maxz) {
+      maxz = regret;
+      ylabel[1] = i;
+      ylabel[2] = jj;
+    }
+  }
+  if (!m_haveBest || maxz < m_bestScaled) {
+    m_haveBest = true;
+    m_bestScaled = maxz;
+    return true;
+  }
+  return false;
+}
+
+bool 
+NashSimpdivStrategySolver::State::ProfileLabel(const PVector<Integer> &y,
+					       Array<int> &ylabel)
+{
+  for (int i = 1; i <= m_numStrats.Length(); i++) {
+    GamePlayer player = m_game->GetPlayer(i);
+    for (int j = 1; j <= m_numStrats[i]; j++) {
+      m_profile[player->GetStrategy(j)] = Rational(y(i, j), m_denom);
+    }
+  }
+
+  Rational maxz;
+  for (int i = 1; i <= m_numStrats.Length(); i++) {
+    GamePlayer player = m_game->GetPlayer(i);
     Rational payoff = 0;
-    Rational maxval = -1000000;
+    Rational maxval;
     int jj = 0;
-    for (int j = 1; j <= player->Strategies().size(); j++) {
-      pay = yy.GetPayoff(player->Strategies()[j]);
-      payoff += yy[player->Strategies()[j]] * pay;
-      if (pay > maxval) {
+    for (int j = 1; j <= m_numStrats[i]; j++) {
+      Rational pay = m_profile.GetPayoff(player->GetStrategy(j));
+      payoff += m_profile[player->GetStrategy(j)] * pay;
+      if (jj == 0 || pay > maxval) {
 	maxval = pay;
 	jj = j;
       }
     }
-    if (maxval - payoff > maxz) {
+    if (i == 1 || maxval - payoff > maxz) {
       maxz = maxval - payoff;
       ylabel[1] = i;
       ylabel[2] = jj;
     }
   }
-  if (maxz < bestz) {
-    bestz = maxz;
-    for (int i = 1; i <= yy.GetGame()->NumPlayers(); i++) {
-      GamePlayer player = yy.GetGame()->Players()[i];
-      for (int j = 1; j <= player->Strategies().size(); j++) {
-	besty(i,j) = yy[player->Strategies()[j]];
-      }
-    }
+  if (!m_haveBest || maxz < m_bestz) {
+    m_haveBest = true;
+    m_bestz = maxz;
+    return true;
   }
-  return maxz;
+  return false;
 }
 
-//-------------------------------------------------------------------------
-//           NashSimpdivStrategySolver: Main solution algorithm
-//-------------------------------------------------------------------------
+bool 
+NashSimpdivStrategySolver::State::getlabel(const PVector<Integer> &y,
+					   Array<int> &ylabel)
+{
+  return (m_isTable) ? TableLabel(y, ylabel) : ProfileLabel(y, ylabel);
+}
 
-inline Integer find_lcd(const Vector<Rational> &vec)
+Rational NashSimpdivStrategySolver::State::GetBestRegret(void) const
 {
-  Integer lcd(1);
-  for (int i = vec.First(); i <= vec.Last(); i++) {
-    lcd = lcm(vec[i].denominator(), lcd);
+  if (!m_isTable) {
+    return m_bestz;
   }
-  return lcd;
+  Integer scale = m_lcd;
+  for (int pl = 1; pl <= m_numStrats.Length(); pl++) {
+    scale *= m_denom;
+  }
+  return Rational(m_bestScaled, scale);
 }
 
+//-------------------------------------------------------------------------
+//           NashSimpdivStrategySolver: Main solution algorithm
+//-------------------------------------------------------------------------
 
-List<MixedStrategyProfile<Rational> >
-NashSimpdivStrategySolver::Solve(const MixedStrategyProfile<Rational> &p_start) const
+//
+// The run is finished when the largest regret at the profile found on a
+// grid is below this tolerance.
+//
+const double SIMPDIV_TOL = 1.0e-10;
+
+bool NashSimpdivStrategySolver::Refine(const Game &p_game,
+				       SimpdivCheckpoint &p_run) const
 {
-  if (!p_start.GetGame()->IsPerfectRecall()) {
+  if (!p_game->IsPerfectRecall()) {
     throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
   }
-  Integer k = find_lcd((const Vector<Rational> &) p_start);
-  Rational d = Rational(1, k);
-    
-  MixedStrategyProfile<Rational> y(p_start);
-  if (m_verbose) {
+  if (p_run.m_finished) {
+    return true;
+  }
+  MixedStrategyProfile<Rational> y(p_run.GetProfile(p_game));
+  if (m_verbose && p_run.m_levels == 0) {
     this->m_onEquilibrium->Render(y, "start");
   }
 
-  while (true) {
-    const double TOL = 1.0e-10;
-    d /= m_gridResize;
-    Rational maxz = Simplex(y, d);
-    
-    if (m_verbose) {
-      this->m_onEquilibrium->Render(y, lexical_cast<std::string>(d));
-    }
-    if (maxz < Rational(TOL)) break;
+  Rational d = p_run.m_grid;
+  d /= m_gridResize;
+  State state(p_game);
+  Rational maxz = Simplex(state, y, d);
+  if (m_verbose) {
+    this->m_onEquilibrium->Render(y, lexical_cast<std::string>(d));
   }
+
+  p_run.m_probs = static_cast<const Vector<Rational> &>(y);
+  p_run.m_grid = d;
+  p_run.m_levels++;
+  p_run.m_finished = (maxz < Rational(SIMPDIV_TOL));
+  return p_run.m_finished;
+}
+
+List<MixedStrategyProfile<Rational> >
+NashSimpdivStrategySolver::Solve(const Game &p_game,
+				 SimpdivCheckpoint &p_run) const
+{
+  while (!Refine(p_game, p_run));
     
+  MixedStrategyProfile<Rational> y(p_run.GetProfile(p_game));
   this->m_onEquilibrium->Render(y);
   List<MixedStrategyProfile<Rational> > sol;
   sol.push_back(y);
   return sol;
 }
 
+List<MixedStrategyProfile<Rational> >
+NashSimpdivStrategySolver::Solve(const MixedStrategyProfile<Rational> &p_start) const
+{
+  SimpdivCheckpoint run(p_start);
+  return Solve(p_start.GetGame(), run);
+}
+
 ///
 /// Compute an equilibrium using the default starting point. 
 ///
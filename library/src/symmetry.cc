@@ -0,0 +1,101 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: library/src/symmetry.cc
+// Classes of interchangeable players and symmetric strategy profiles
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include "gambit/gambit.h"
+#include "gambit/symmetry.h"
+
+namespace Gambit {
+
+//===========================================================================
+//                          class PlayerClasses
+//===========================================================================
+
+void PlayerClasses::Initialize(const Game &p_game)
+{
+  if (m_classes.Length() != p_game->NumPlayers()) {
+    throw DimensionException();
+  }
+  m_fullOffsets = Array<int>(m_classes.Length());
+  m_fullLength = 0;
+  for (int pl = 1; pl <= m_classes.Length(); pl++) {
+    int cls = m_classes[pl];
+    if (cls < 1 || cls > m_members.Length() + 1) {
+      throw IndexException();
+    }
+    int numStrats = p_game->GetPlayer(pl)->NumStrategies();
+    if (cls > m_members.Length()) {
+      m_members.Append(Array<int>());
+      m_numStrategies.Append(numStrats);
+    }
+    else if (m_numStrategies[cls] != numStrats) {
+      throw DimensionException();
+    }
+    m_members[cls].Append(pl);
+    m_fullOffsets[pl] = m_fullLength;
+    m_fullLength += numStrats;
+  }
+
+  m_reducedOffsets = Array<int>(m_members.Length());
+  m_reducedLength = 0;
+  for (int cls = 1; cls <= m_members.Length(); cls++) {
+    m_reducedOffsets[cls] = m_reducedLength;
+    m_reducedLength += m_numStrategies[cls];
+  }
+}
+
+Vector<double> PlayerClasses::Expand(const Vector<double> &p_reduced) const
+{
+  Vector<double> full(m_fullLength);
+  for (int pl = 1; pl <= m_classes.Length(); pl++) {
+    int cls = m_classes[pl];
+    for (int st = 1; st <= m_numStrategies[cls]; st++) {
+      full[m_fullOffsets[pl] + st] = p_reduced[m_reducedOffsets[cls] + st];
+    }
+  }
+  return full;
+}
+
+Vector<double> PlayerClasses::Fold(const Vector<double> &p_full) const
+{
+  Vector<double> reduced(m_reducedLength);
+  reduced = 0.0;
+  for (int pl = 1; pl <= m_classes.Length(); pl++) {
+    int cls = m_classes[pl];
+    for (int st = 1; st <= m_numStrategies[cls]; st++) {
+      reduced[m_reducedOffsets[cls] + st] += p_full[m_fullOffsets[pl] + st];
+    }
+  }
+  return reduced;
+}
+
+Vector<double> PlayerClasses::Average(const Vector<double> &p_full) const
+{
+  Vector<double> reduced(Fold(p_full));
+  for (int cls = 1; cls <= m_members.Length(); cls++) {
+    for (int st = 1; st <= m_numStrategies[cls]; st++) {
+      reduced[m_reducedOffsets[cls] + st] /= (double) m_members[cls].Length();
+    }
+  }
+  return reduced;
+}
+
+}  // end namespace Gambit
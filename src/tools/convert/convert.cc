@@ -22,7 +22,7 @@
 
 #include <iostream>
 #include <iomanip>
-#include <fstream>
+#include <cstdio>
 #include <cstdlib>
 #include <unistd.h>
 
@@ -49,6 +49,9 @@ void PrintHelp(char *progname)
   std::cerr << "  -O FORMAT        output file format (required):\n";
   std::cerr << "     FORMAT=html   convert to HTML\n";
   std::cerr << "     FORMAT=sgame  convert to LaTeX sgame style\n";
+  std::cerr << "     FORMAT=nfg    convert to .nfg strategic game savefile\n";
+  std::cerr << "     FORMAT=efg    convert to .efg extensive game savefile\n";
+  std::cerr << "     FORMAT=binary convert to binary savefile\n";
   std::cerr << "  -c PLAYER        the player to show on columns (default is 2)\n";
   std::cerr << "  -r PLAYER        the player to show on rows (default is 1)\n";
   std::cerr << "  -h               print this help message\n";
@@ -102,7 +105,8 @@ int main(int argc, char *argv[])
     std::cerr << argv[0] << ": Output format argument -O required.\n";
     return 1;
   }
-  else if (format != "sgame" && format != "html") {
+  else if (format != "sgame" && format != "html" &&
+	   format != "nfg" && format != "efg" && format != "binary") {
     std::cerr << argv[0] << ": Unknown output format '" << format << "'.\n";
     return 1;
   }
@@ -112,21 +116,23 @@ int main(int argc, char *argv[])
     return 1;
   }
 
-  std::istream* input_stream = &std::cin;
-  std::ifstream file_stream;
-  if (optind < argc) {
-    file_stream.open(argv[optind]);
-    if (!file_stream.is_open()) {
-      std::ostringstream error_message;
-      error_message << argv[0] << ": " << argv[optind];
-      perror(error_message.str().c_str());
-      exit(1);
-    }
-    input_stream = &file_stream;
+  if (optind < argc && access(argv[optind], R_OK) != 0) {
+    std::ostringstream error_message;
+    error_message << argv[0] << ": " << argv[optind];
+    perror(error_message.str().c_str());
+    exit(1);
   }
 
   try {
-    Gambit::Game game = Gambit::ReadGame(*input_stream);
+    // Files named on the command line are mapped into memory rather
+    // than read through a stream
+    Gambit::Game game = (optind < argc) ?
+      Gambit::ReadGameFile(argv[optind]) : Gambit::ReadGame(std::cin);
+
+    if (format == "nfg" || format == "efg" || format == "binary") {
+      game->Write(std::cout, format);
+      return 0;
+    }
 
     if (rowPlayer < 1 || rowPlayer > game->NumPlayers()) {
       std::cerr << argv[0] << ": Player " << rowPlayer << " does not exist.\n";
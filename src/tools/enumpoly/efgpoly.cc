@@ -22,6 +22,8 @@
 
 #include <iostream>
 #include <iomanip>
+#include <sstream>
+#include <vector>
 #include "gambit/gambit.h"
 
 using namespace Gambit;
@@ -33,9 +35,11 @@ using namespace Gambit;
 #include "rectangl.h"
 #include "quiksolv.h"
 #include "behavextend.h"
+#include "supportout.h"
 
 extern int g_numDecimals;
 extern bool g_verbose;
+extern bool g_ordered;
 
 //
 // A class to organize the data needed to build the polynomials
@@ -390,25 +394,75 @@ void SolveExtensive(const Game &p_game)
 {
   List<BehaviorSupportProfile> supports = PossibleNashSubsupports(p_game);
 
+  // Game objects may not be shared between threads, so each thread
+  // solves on its own copy of the game, and each support is passed
+  // to it as flags marking the actions it contains.
+  std::vector<std::vector<bool> > contents(supports.Length());
   for (int i = 1; i <= supports.Length(); i++) {
-    if (g_verbose) {
-      PrintSupport(std::cout, "candidate", supports[i]);
+    for (int pl = 1; pl <= p_game->NumPlayers(); pl++) {
+      GamePlayer player = p_game->GetPlayer(pl);
+      for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+	GameInfoset infoset = player->GetInfoset(iset);
+	for (int act = 1; act <= infoset->NumActions(); act++) {
+	  contents[i-1].push_back(supports[i].Contains(infoset->GetAction(act)));
+	}
+      }
     }
+  }
+
+  std::vector<Game> games(NumSupportThreads());
+  games[0] = p_game;
+  for (size_t t = 1; t < games.size(); t++) {
+    games[t] = p_game->Copy();
+  }
+
+  SupportOutput output(std::cout, supports.Length(), g_ordered);
+
+#pragma omp parallel for schedule(dynamic, 1)
+  for (int i = 1; i <= supports.Length(); i++) {
+    const Game &efg = games[SupportThreadNumber()];
+    std::ostringstream text;
+
+    try {
+      BehaviorSupportProfile support(efg);
+      for (int pl = 1, index = 0; pl <= efg->NumPlayers(); pl++) {
+	GamePlayer player = efg->GetPlayer(pl);
+	for (int iset = 1; iset <= player->NumInfosets(); iset++) {
+	  GameInfoset infoset = player->GetInfoset(iset);
+	  for (int act = 1; act <= infoset->NumActions(); act++) {
+	    if (!contents[i-1][index++]) {
+	      support.RemoveAction(infoset->GetAction(act));
+	    }
+	  }
+	}
+      }
+
+      if (g_verbose) {
+	PrintSupport(text, "candidate", support);
+      }
       
-    bool isSingular = false;
-    List<MixedBehaviorProfile<double> > newsolns = 
-      SolveSupport(supports[i], isSingular);
-
-    for (int j = 1; j <= newsolns.Length(); j++) {
-      MixedBehaviorProfile<double> fullProfile = ToFullSupport(newsolns[j]);
-      if (fullProfile.GetLiapValue(true) < 1.0e-6) {
-	PrintProfile(std::cout, "NE", fullProfile);
+      bool isSingular = false;
+      List<MixedBehaviorProfile<double> > newsolns = 
+	SolveSupport(support, isSingular);
+
+      for (int j = 1; j <= newsolns.Length(); j++) {
+	MixedBehaviorProfile<double> fullProfile = ToFullSupport(newsolns[j]);
+	if (fullProfile.GetLiapValue(true) < 1.0e-6) {
+	  PrintProfile(text, "NE", fullProfile);
+	}
       }
-    }
       
-    if (isSingular && g_verbose) {
-      PrintSupport(std::cout, "singular", supports[i]);
+      if (isSingular && g_verbose) {
+	PrintSupport(text, "singular", support);
+      }
+    }
+    catch (std::runtime_error &e) {
+      output.Fail(e.what());
     }
+
+    output.Report(i, text.str());
   }
+
+  output.CheckErrors();
 }
 
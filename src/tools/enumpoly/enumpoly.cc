@@ -31,6 +31,7 @@
 
 int g_numDecimals = 6;
 bool g_verbose = false;
+bool g_ordered = false;
 
 void PrintBanner(std::ostream &p_stream)
 {
@@ -50,6 +51,8 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      show equilibrium probabilities with DECIMALS digits\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  -O               report results in the order of a serial search\n";
+  std::cerr << "                   (default is to report them as they are found)\n";
   std::cerr << "  -S               use strategic game\n";
   std::cerr << "  -H               use heuristic search method to optimize time\n";
   std::cerr << "                   to find first equilibrium (strategic games only)\n";
@@ -78,7 +81,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:hHSqvV", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:hHOSqvV", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -91,6 +94,9 @@ int main(int argc, char *argv[])
     case 'H':
       useHeuristic = true;
       break;
+    case 'O':
+      g_ordered = true;
+      break;
     case 'S':
       useStrategic = true;
       break;
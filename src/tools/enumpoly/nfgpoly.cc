@@ -23,15 +23,19 @@
 
 #include <iostream>
 #include <iomanip>
+#include <sstream>
+#include <vector>
 
 #include "nfgensup.h"
 #include "gpoly.h"
 #include "gpolylst.h"
 #include "rectangl.h"
 #include "quiksolv.h"
+#include "supportout.h"
 
 extern int g_numDecimals;
 extern bool g_verbose; 
+extern bool g_ordered;
 
 class PolEnumModule  {
 private:
@@ -482,29 +486,73 @@ void SolveStrategic(const Gambit::Game &p_nfg)
 {
   Gambit::List<Gambit::StrategySupportProfile> supports = PossibleNashSubsupports(p_nfg);
 
+  // Game objects may not be shared between threads, so each thread
+  // solves on its own copy of the game, and each support is passed
+  // to it as flags marking the strategies it contains.
+  std::vector<std::vector<bool> > contents(supports.Length());
   for (int i = 1; i <= supports.Length(); i++) {
-    long newevals = 0;
-    double newtime = 0.0;
-    Gambit::List<Gambit::MixedStrategyProfile<double> > newsolns;
-    bool is_singular = false;
-    
-    if (g_verbose) {
-      PrintSupport(std::cout, "candidate", supports[i]);
+    for (int pl = 1; pl <= p_nfg->NumPlayers(); pl++) {
+      Gambit::GamePlayer player = p_nfg->GetPlayer(pl);
+      for (int st = 1; st <= player->NumStrategies(); st++) {
+	contents[i-1].push_back(supports[i].Contains(player->GetStrategy(st)));
+      }
     }
+  }
+
+  std::vector<Gambit::Game> games(NumSupportThreads());
+  games[0] = p_nfg;
+  for (size_t t = 1; t < games.size(); t++) {
+    games[t] = p_nfg->Copy();
+  }
+
+  SupportOutput output(std::cout, supports.Length(), g_ordered);
+
+#pragma omp parallel for schedule(dynamic, 1)
+  for (int i = 1; i <= supports.Length(); i++) {
+    const Gambit::Game &nfg = games[SupportThreadNumber()];
+    std::ostringstream text;
+
+    try {
+      Gambit::StrategySupportProfile support(nfg);
+      for (int pl = 1, index = 0; pl <= nfg->NumPlayers(); pl++) {
+	Gambit::GamePlayer player = nfg->GetPlayer(pl);
+	for (int st = 1; st <= player->NumStrategies(); st++) {
+	  if (!contents[i-1][index++]) {
+	    support.RemoveStrategy(player->GetStrategy(st));
+	  }
+	}
+      }
 
-    PolEnum(supports[i], newsolns, newevals, newtime, is_singular);
+      long newevals = 0;
+      double newtime = 0.0;
+      Gambit::List<Gambit::MixedStrategyProfile<double> > newsolns;
+      bool is_singular = false;
+    
+      if (g_verbose) {
+	PrintSupport(text, "candidate", support);
+      }
+
+      PolEnum(support, newsolns, newevals, newtime, is_singular);
       
-    for (int j = 1; j <= newsolns.Length(); j++) {
-      Gambit::MixedStrategyProfile<double> fullProfile = ToFullSupport(newsolns[j]);
-      if (fullProfile.GetLiapValue() < 1.0e-6) {
-	PrintProfile(std::cout, "NE", fullProfile);
+      for (int j = 1; j <= newsolns.Length(); j++) {
+	Gambit::MixedStrategyProfile<double> fullProfile = ToFullSupport(newsolns[j]);
+	if (fullProfile.GetLiapValue() < 1.0e-6) {
+	  PrintProfile(text, "NE", fullProfile);
+	}
       }
-    }
 
-    if (is_singular && g_verbose) {
-      PrintSupport(std::cout, "singular", supports[i]);
+      if (is_singular && g_verbose) {
+	PrintSupport(text, "singular", support);
+      }
+    }
+    catch (std::runtime_error &e) {
+      output.Fail(e.what());
     }
+
+    output.Report(i, text.str());
   }
+
+  output.CheckErrors();
 }
 
 
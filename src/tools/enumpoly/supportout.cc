@@ -0,0 +1,88 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/enumpoly/supportout.cc
+// Reporting the results of solving candidate supports in parallel
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#include <stdexcept>
+#ifdef _OPENMP
+#include <omp.h>
+#endif  // _OPENMP
+
+#include "supportout.h"
+
+int NumSupportThreads(void)
+{
+#ifdef _OPENMP
+  return omp_get_max_threads();
+#else
+  return 1;
+#endif  // _OPENMP
+}
+
+int SupportThreadNumber(void)
+{
+#ifdef _OPENMP
+  return omp_get_thread_num();
+#else
+  return 0;
+#endif  // _OPENMP
+}
+
+SupportOutput::SupportOutput(std::ostream &p_stream, int p_numSupports,
+			     bool p_ordered)
+  : m_stream(p_stream), m_ordered(p_ordered),
+    m_text(p_numSupports), m_done(p_numSupports, false), m_next(0)
+{ }
+
+void SupportOutput::Report(int p_index, const std::string &p_text)
+{
+#pragma omp critical(enumpoly_output)
+  {
+    if (!m_ordered) {
+      m_stream << p_text << std::flush;
+    }
+    else {
+      m_text[p_index - 1] = p_text;
+      m_done[p_index - 1] = true;
+      for (; m_next < (int) m_done.size() && m_done[m_next]; m_next++) {
+	m_stream << m_text[m_next];
+	std::string().swap(m_text[m_next]);
+      }
+      m_stream << std::flush;
+    }
+  }
+}
+
+void SupportOutput::Fail(const std::string &p_message)
+{
+#pragma omp critical(enumpoly_output)
+  {
+    if (m_error.empty()) {
+      m_error = p_message;
+    }
+  }
+}
+
+void SupportOutput::CheckErrors(void) const
+{
+  if (!m_error.empty()) {
+    throw std::runtime_error(m_error);
+  }
+}
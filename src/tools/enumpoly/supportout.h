@@ -0,0 +1,62 @@
+//
+// This file is part of Gambit
+// Copyright (c) 1994-2016, The Gambit Project (http://www.gambit-project.org)
+//
+// FILE: src/tools/enumpoly/supportout.h
+// Reporting the results of solving candidate supports in parallel
+//
+// This program is free software; you can redistribute it and/or modify
+// it under the terms of the GNU General Public License as published by
+// the Free Software Foundation; either version 2 of the License, or
+// (at your option) any later version.
+//
+// This program is distributed in the hope that it will be useful,
+// but WITHOUT ANY WARRANTY; without even the implied warranty of
+// MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+// GNU General Public License for more details.
+//
+// You should have received a copy of the GNU General Public License
+// along with this program; if not, write to the Free Software
+// Foundation, Inc., 59 Temple Place - Suite 330, Boston, MA 02111-1307, USA.
+//
+
+#ifndef SUPPORTOUT_H
+#define SUPPORTOUT_H
+
+#include <iostream>
+#include <string>
+#include <vector>
+
+/// Returns the number of threads used to solve supports
+int NumSupportThreads(void);
+/// Returns the number of the calling thread, from zero
+int SupportThreadNumber(void);
+
+//
+// Candidate supports are solved independently, each by whichever thread
+// is free to take it next.  The output from solving each support is
+// written out as soon as the support is finished, or, if ordered output
+// is requested, as soon as all the supports before it are finished,
+// so that the output is the same as that of solving them one after another.
+//
+class SupportOutput {
+private:
+  std::ostream &m_stream;
+  bool m_ordered;
+  std::vector<std::string> m_text;
+  std::vector<bool> m_done;
+  int m_next;
+  std::string m_error;
+
+public:
+  SupportOutput(std::ostream &p_stream, int p_numSupports, bool p_ordered);
+
+  /// Reports the output from solving support number p_index (from 1)
+  void Report(int p_index, const std::string &p_text);
+  /// Records an error while solving a support; the first is kept
+  void Fail(const std::string &p_message);
+  /// Throws the first error recorded, if any
+  void CheckErrors(void) const;
+};
+
+#endif  // SUPPORTOUT_H
@@ -86,8 +86,12 @@ void PrintHelp(char *progname)
   std::cerr << "  -d DECIMALS      show equilibria as floating point with DECIMALS digits\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -n COUNT         number of perturbation vectors to generate\n";
+  std::cerr << "  -D TOL           report equilibria closer than TOL to one already\n";
+  std::cerr << "                   reported only once (default is 1e-4; 0 reports all)\n";
   std::cerr << "  -s FILE          file containing perturbation vectors\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
+  std::cerr << "  -y, --symmetric  compute only equilibria in which interchangeable\n";
+  std::cerr << "                   players play the same strategy\n";
   std::cerr << "  -V, --verbose    verbose mode (shows intermediate output)\n";
   std::cerr << "  -v, --version    print version information\n";
   std::cerr << "                   (default is to only show equilibria)\n";
@@ -97,8 +101,9 @@ void PrintHelp(char *progname)
 int main(int argc, char *argv[])
 {
   opterr = 0;
-  bool quiet = false, verbose = false;
+  bool quiet = false, verbose = false, symmetric = false;
   int numDecimals = 6, numVectors = 1;
+  double tolerance = 1.0e-4;
   std::string startFile;
 
   int long_opt_index = 0;
@@ -106,10 +111,11 @@ int main(int argc, char *argv[])
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
     { "verbose", 0, NULL, 'V'  },
+    { "symmetric", 0, NULL, 'y'  },
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:n:s:qvVhS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:D:n:s:qvVhSy", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -122,6 +128,9 @@ int main(int argc, char *argv[])
     case 'd':
       numDecimals = atoi(optarg);
       break;
+    case 'D':
+      tolerance = atof(optarg);
+      break;
     case 'n':
       numVectors = atoi(optarg);
       break;
@@ -130,6 +139,9 @@ int main(int argc, char *argv[])
       break;
     case 'S':
       break;
+    case 'y':
+      symmetric = true;
+      break;
     case 'h':
       PrintHelp(argv[0]);
       break;
@@ -168,7 +180,7 @@ int main(int argc, char *argv[])
     shared_ptr<StrategyProfileRenderer<double> > renderer;
     renderer = new MixedStrategyCSVRenderer<double>(std::cout,
 						    numDecimals);
-    NashGNMStrategySolver solver(renderer, verbose);
+    NashGNMStrategySolver solver(renderer, verbose, tolerance, symmetric);
 
     List<MixedStrategyProfile<double> > perts;
     if (startFile != "") {
@@ -179,9 +191,7 @@ int main(int argc, char *argv[])
       // Generate the desired number of points randomly
       perts = RandomStrategyPerturbations(game, numVectors);
     }
-    for (int i = 1; i <= perts.size(); i++) {
-      solver.Solve(game, perts[i]);
-    }
+    solver.Solve(game, perts);
     return 0;
   }
   catch (std::runtime_error &e) {
@@ -32,6 +32,41 @@ using namespace Gambit;
 using namespace Gambit::Nash;
 using namespace Gambit::gametracer;
 
+List<MixedStrategyProfile<double> > 
+ReadStrategyPerturbations(const Game &p_game, std::istream &p_stream)
+{
+  List<MixedStrategyProfile<double> > profiles;
+  while (!p_stream.eof() && !p_stream.bad()) {
+    MixedStrategyProfile<double> p(p_game->NewMixedStrategyProfile(0.0));
+    for (int i = 1; i <= p.MixedProfileLength(); i++) {
+      if (p_stream.eof() || p_stream.bad()) {
+	break;
+      }
+      p_stream >> p[i];
+      if (i < p.MixedProfileLength()) {
+	char comma;
+	p_stream >> comma;
+      }
+    }
+    // Read in the rest of the line and discard
+    std::string foo;
+    std::getline(p_stream, foo);
+    profiles.push_back(p);
+  }
+  return profiles;
+}
+
+List<MixedStrategyProfile<double> > 
+RandomStrategyPerturbations(const Game &p_game, int p_count)
+{
+  List<MixedStrategyProfile<double> > profiles;
+  for (int i = 1; i <= p_count; i++) {
+    MixedStrategyProfile<double> p(p_game->NewMixedStrategyProfile(0.0));
+    p.Randomize();
+    profiles.push_back(p);
+  }
+  return profiles;
+}
 
 void PrintBanner(std::ostream &p_stream)
 {
@@ -50,6 +85,10 @@ void PrintHelp(char *progname)
   std::cerr << "Options:\n";
   std::cerr << "  -d DECIMALS      show equilibria as floating point with DECIMALS digits\n";
   std::cerr << "  -h, --help       print this help message\n";
+  std::cerr << "  -n COUNT         number of perturbation vectors to generate\n";
+  std::cerr << "  -s FILE          file containing perturbation vectors\n";
+  std::cerr << "  -D TOL           report equilibria closer than TOL to one already\n";
+  std::cerr << "                   reported only once (default is 1e-4; 0 reports all)\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -V, --verbose    verbose mode (shows intermediate output)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -61,7 +100,9 @@ int main(int argc, char *argv[])
 {
   opterr = 0;
   bool quiet = false, verbose = false;
-  int numDecimals = 6;
+  int numDecimals = 6, numVectors = 0;
+  double tolerance = 1.0e-4;
+  std::string startFile;
 
   int long_opt_index = 0;
   struct option long_options[] = {
@@ -71,7 +112,7 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:vVqhS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:D:n:s:vVqhS", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -84,6 +125,15 @@ int main(int argc, char *argv[])
     case 'd':
       numDecimals = atoi(optarg);
       break;
+    case 'D':
+      tolerance = atof(optarg);
+      break;
+    case 'n':
+      numVectors = atoi(optarg);
+      break;
+    case 's':
+      startFile = optarg;
+      break;
     case 'S':
       break;
     case 'h':
@@ -124,8 +174,19 @@ int main(int argc, char *argv[])
     shared_ptr<StrategyProfileRenderer<double> > renderer;
     renderer = new MixedStrategyCSVRenderer<double>(std::cout,
 						    numDecimals);
-    NashIPAStrategySolver solver(renderer);
-    solver.Solve(game);
+    NashIPAStrategySolver solver(renderer, tolerance);
+
+    if (startFile != "") {
+      std::ifstream startPerts(startFile.c_str());
+      solver.Solve(game, ReadStrategyPerturbations(game, startPerts));
+    }
+    else if (numVectors > 0) {
+      // Generate the desired number of points randomly
+      solver.Solve(game, RandomStrategyPerturbations(game, numVectors));
+    }
+    else {
+      solver.Solve(game);
+    }
     return 0;
   }
   catch (std::runtime_error &e) {
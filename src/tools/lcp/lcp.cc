@@ -51,6 +51,8 @@ void PrintHelp(char *progname)
   std::cerr << "                   display results with DECIMALS digits\n";
   std::cerr << "  -S               use strategic game\n";
   std::cerr << "  -P               find only subgame-perfect equilibria\n";
+  std::cerr << "  -s               use sparse sequence form for extensive games\n";
+  std::cerr << "                   (finds one equilibrium)\n";
   std::cerr << "  -e EQA           terminate after finding EQA equilibria\n";
   std::cerr << "                   (default is to find all accessible equilbria\n";
   std::cerr << "  -r DEPTH         terminate recursion at DEPTH\n";
@@ -67,7 +69,7 @@ int main(int argc, char *argv[])
 {
   int c;
   bool useFloat = false, useStrategic = false, bySubgames = false, quiet = false;
-  bool printDetail = false;
+  bool printDetail = false, useSparse = false;
   int numDecimals = 6, stopAfter = 0, maxDepth = 0;
 
   int long_opt_index = 0;
@@ -76,7 +78,7 @@ int main(int argc, char *argv[])
     { "version", 0, NULL, 'v'  },
     { 0,    0,    0,    0   }
   };
-  while ((c = getopt_long(argc, argv, "d:DvhqSPe:r:", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:DvhqSPse:r:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -105,6 +107,9 @@ int main(int argc, char *argv[])
     case 'P':
       bySubgames = true;
       break;
+    case 's':
+      useSparse = true;
+      break;
     case '?':
       if (isprint(optopt)) {
 	std::cerr << argv[0] << ": Unknown option `-" << ((char) optopt) << "'.\n";
@@ -176,7 +181,8 @@ int main(int argc, char *argv[])
 	    renderer = new BehavStrategyCSVRenderer<double>(std::cout, 
 							    numDecimals);
 	  }
-	  NashLcpBehaviorSolver<double> algorithm(stopAfter, maxDepth, renderer);
+	  NashLcpBehaviorSolver<double> algorithm(stopAfter, maxDepth, renderer,
+						  useSparse);
 	  algorithm.Solve(game);
 	}
 	else {
@@ -187,14 +193,15 @@ int main(int argc, char *argv[])
 	  else {
 	    renderer = new BehavStrategyCSVRenderer<Rational>(std::cout);
 	  }
-	  NashLcpBehaviorSolver<Rational> algorithm(stopAfter, maxDepth, renderer);
+	  NashLcpBehaviorSolver<Rational> algorithm(stopAfter, maxDepth, renderer,
+						    useSparse);
 	  algorithm.Solve(game);
 	}
       }
       else {
 	if (useFloat) {
 	  shared_ptr<BehavSolver<double> > stage = 
-	    new NashLcpBehaviorSolver<double>(stopAfter, maxDepth);
+	    new NashLcpBehaviorSolver<double>(stopAfter, maxDepth, 0, useSparse);
 	  shared_ptr<StrategyProfileRenderer<double> > renderer;
 	  if (printDetail)  {
 	    renderer = new BehavStrategyDetailRenderer<double>(std::cout,
@@ -209,7 +216,7 @@ int main(int argc, char *argv[])
 	}
 	else {
 	  shared_ptr<BehavSolver<Rational> > stage = 
-	    new NashLcpBehaviorSolver<Rational>(stopAfter, maxDepth);
+	    new NashLcpBehaviorSolver<Rational>(stopAfter, maxDepth, 0, useSparse);
 	  shared_ptr<StrategyProfileRenderer<Rational> > renderer;
 	  if (printDetail)  {
 	    renderer = new BehavStrategyDetailRenderer<Rational>(std::cout,
@@ -53,7 +53,7 @@ private:
 
 double AgentLyapunovFunction::Value(const Vector<double> &v) const
 {
-  static_cast<Vector<double> &>(m_profile).operator=(v);
+  m_profile = v;
   return m_profile.GetLiapValue();
 }
 
@@ -61,7 +61,7 @@ bool AgentLyapunovFunction::Gradient(const Vector<double> &x,
 				     Vector<double> &grad) const
 {
   const double DELTA = .00001;
-  static_cast<Vector<double> &>(m_profile).operator=(x);
+  m_profile = x;
   for (int i = 1; i <= x.Length(); i++) {
     m_profile[i] += DELTA;
     double value = m_profile.GetLiapValue();
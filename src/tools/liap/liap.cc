@@ -26,6 +26,7 @@
 #include <cstdlib>
 #include <unistd.h>
 #include <getopt.h>
+#include <vector>
 #include "gambit/gambit.h"
 #include "efgliap.h"
 #include "nfgliap.h"
@@ -50,8 +51,12 @@ void PrintHelp(char *progname)
   std::cerr << "  -d DECIMALS      print probabilities with DECIMALS digits\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -n COUNT         number of starting points to generate\n";
+  std::cerr << "  -D TOL           report equilibria closer than TOL to one already\n";
+  std::cerr << "                   reported only once (default is 0.01; 0 reports all)\n";
   std::cerr << "  -s FILE          file containing starting points\n";
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
+  std::cerr << "  -y, --symmetric  compute only equilibria in which interchangeable\n";
+  std::cerr << "                   players play the same strategy (strategic form only)\n";
   std::cerr << "  -V, --verbose    verbose mode (shows intermediate output)\n";
   std::cerr << "                   (default is to only show equilibria)\n";
   std::cerr << "  -v, --version    print version information\n";
@@ -130,14 +135,78 @@ RandomBehaviorProfiles(const Game &p_game, int p_count)
   return profiles;
 }
 
+template <class Profile>
+Profile NewProfile(const Game &p_game, const Vector<double> &p_probs);
+
+template<> MixedStrategyProfile<double>
+NewProfile(const Game &p_game, const Vector<double> &p_probs)
+{
+  MixedStrategyProfile<double> profile(p_game->NewMixedStrategyProfile(0.0));
+  static_cast<Vector<double> &>(profile) = p_probs;
+  return profile;
+}
+
+template<> MixedBehaviorProfile<double>
+NewProfile(const Game &p_game, const Vector<double> &p_probs)
+{
+  MixedBehaviorProfile<double> profile(p_game);
+  profile = p_probs;
+  return profile;
+}
+
+template <class Solver>
+void SetSymmetric(Solver &p_solver, bool p_symmetric);
+
+template<> void
+SetSymmetric(NashLiapStrategySolver &p_solver, bool p_symmetric)
+{ p_solver.SetSymmetric(p_symmetric); }
+
+template<> void
+SetSymmetric(NashLiapBehavSolver &p_solver, bool p_symmetric)
+{ }
+
+//
+// Starting points are minimized independently, each by whichever thread
+// is free to take it next, on that thread's copy of the game.
+//
+template <class Profile, class Solver>
+void SolveStarts(const Game &p_game, const List<Profile> &p_starts,
+		 int p_maxitsN, bool p_verbose, bool p_symmetric,
+		 double p_tolerance,
+		 const StrategyProfileRenderer<double> &p_renderer)
+{
+  std::vector<Vector<double> > starts;
+  for (int i = 1; i <= p_starts.size(); i++) {
+    starts.push_back(p_starts[i]);
+  }
+  ProfileSweep<double> sweep(p_game, starts.size(), p_tolerance, p_renderer);
+
+#pragma omp parallel for schedule(dynamic, 1)
+  for (int i = 1; i <= (int) starts.size(); i++) {
+    try {
+      Solver algorithm(p_maxitsN, p_verbose, sweep.GetRecorder(i));
+      SetSymmetric(algorithm, p_symmetric);
+      algorithm.Solve(NewProfile<Profile>(sweep.GetThreadGame(), starts[i-1]));
+    }
+    catch (std::runtime_error &e) {
+      sweep.Fail(e.what());
+    }
+    sweep.Finish(i);
+  }
+
+  sweep.CheckErrors();
+}
+
 int main(int argc, char *argv[])
 {
   opterr = 0;
   bool quiet = false, useStrategic = false, useRandom = false, verbose = false;
+  bool symmetric = false;
   int numTries = 10;
   int maxitsN = 100;
   int numDecimals = 6;
   double tolN = 1.0e-10;
+  double dedupTol = 1.0e-2;
   std::string startFile = "";
  
   int long_opt_index = 0;
@@ -145,16 +214,20 @@ int main(int argc, char *argv[])
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
     { "verbose", 0, NULL, 'V'  },
+    { "symmetric", 0, NULL, 'y'  },
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:n:s:hqVvS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:D:n:s:hqVvSy", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
     case 'd':
       numDecimals = atoi(optarg);
       break;
+    case 'D':
+      dedupTol = atof(optarg);
+      break;
     case 'n':
       numTries = atoi(optarg);
       break;
@@ -167,6 +240,10 @@ int main(int argc, char *argv[])
     case 'S':
       useStrategic = true;
       break;
+    case 'y':
+      symmetric = true;
+      useStrategic = true;
+      break;
     case 'q':
       quiet = true;
       break;
@@ -216,13 +293,9 @@ int main(int argc, char *argv[])
 	starts = RandomStrategyProfiles(game, numTries);
       }
 
-      for (int i = 1; i <= starts.size(); i++) {
-	shared_ptr<StrategyProfileRenderer<double> > renderer;
-	renderer = new MixedStrategyCSVRenderer<double>(std::cout,
-							numDecimals);
-	NashLiapStrategySolver algorithm(maxitsN, verbose, renderer);
-	algorithm.Solve(starts[i]);
-      }
+      MixedStrategyCSVRenderer<double> renderer(std::cout, numDecimals);
+      SolveStarts<MixedStrategyProfile<double>, NashLiapStrategySolver>
+	(game, starts, maxitsN, verbose, symmetric, dedupTol, renderer);
     }
     else {
       List<MixedBehaviorProfile<double> > starts;
@@ -235,13 +308,9 @@ int main(int argc, char *argv[])
 	starts = RandomBehaviorProfiles(game, numTries);
       }
 
-      for (int i = 1; i <= starts.size(); i++) {
-	shared_ptr<StrategyProfileRenderer<double> > renderer;
-	renderer = new BehavStrategyCSVRenderer<double>(std::cout,
-							numDecimals);
-	NashLiapBehavSolver algorithm(maxitsN, verbose, renderer);
-	algorithm.Solve(starts[i]);
-      }
+      BehavStrategyCSVRenderer<double> renderer(std::cout, numDecimals);
+      SolveStarts<MixedBehaviorProfile<double>, NashLiapBehavSolver>
+	(game, starts, maxitsN, verbose, false, dedupTol, renderer);
     }
     return 0;
   }
@@ -27,6 +27,7 @@
 
 #include "gambit/gambit.h"
 #include "gambit/function.h"
+#include "gambit/symmetry.h"
 #include "nfgliap.h"
 
 using namespace Gambit;
@@ -48,49 +49,59 @@ private:
 
   double Value(const Vector<double> &) const;
   bool Gradient(const Vector<double> &, Vector<double> &) const;
-
-  double LiapDerivValue(int, int, const MixedStrategyProfile<double> &) const;
 };
 
-double 
-StrategicLyapunovFunction::LiapDerivValue(int i1, int j1,
-					  const MixedStrategyProfile<double> &p) const
+//
+// The gradient is assembled player by player.  For player i, with
+// regrets r_ij = max(0, u_i(s_ij) - u_i(p)), the only terms of the
+// Lyapunov function which depend on the probability of a strategy t of
+// another player are sum_j r_ij^2, with derivative
+//   2 sum_j r_ij (d u_i(s_ij) / d p_t - sum_k p_ik d u_i(s_ik) / d p_t),
+// so all of them are obtained from one row combination of the matrix of
+// second derivatives returned by GetPayoffDerivs().  With respect to
+// player i's own strategy t, the derivative is -2 sum_j r_ij u_i(t).
+//
+bool 
+StrategicLyapunovFunction::Gradient(const Vector<double> &v, Vector<double> &d) const
 {
-  GameStrategy wrt_strategy = m_game->Players()[i1]->Strategies()[j1];
-  double x = 0.0;
-  for (int i = 1; i <= m_game->NumPlayers(); i++)  {
-    double psum = 0.0;
-    GamePlayer player = m_game->Players()[i];
-    for (int j = 1; j <= player->NumStrategies(); j++)  {
-      GameStrategy strategy = player->Strategies()[j];
-      psum += p[strategy];
-      double x1 = p.GetPayoff(strategy) - p.GetPayoff(i);
-      if (i1 == i) {
-	if (x1 > 0.0)
-	  x -= x1 * p.GetPayoffDeriv(i, wrt_strategy);
+  static_cast<Vector<double> &>(m_profile).operator=(v);
+  d = 0.0;
+  for (int pl = 1, offset = 0; pl <= m_game->NumPlayers(); pl++) {
+    const GamePlayer &player = m_game->Players()[pl];
+    int numStrategies = player->NumStrategies();
+    Vector<double> values = m_profile.GetStrategyValues(player);
+    Matrix<double> derivs = m_profile.GetPayoffDerivs(player);
+
+    double payoff = 0.0, psum = 0.0;
+    for (int st = 1; st <= numStrategies; st++) {
+      payoff += v[offset + st] * values[st];
+      psum += v[offset + st];
+    }
+    Vector<double> regrets(numStrategies);
+    double totalRegret = 0.0;
+    for (int st = 1; st <= numStrategies; st++) {
+      regrets[st] = (values[st] > payoff) ? values[st] - payoff : 0.0;
+      totalRegret += regrets[st];
+    }
+
+    for (int col = 1; col <= v.Length(); col++) {
+      if (col > offset && col <= offset + numStrategies) {
+	d[col] += 2.0 * (100.0 * (psum - 1.0) -
+			 totalRegret * values[col - offset]);
       }
-      else if (x1 > 0.0) {
-	x += x1 * (p.GetPayoffDeriv(i, strategy, wrt_strategy) - 
-		   p.GetPayoffDeriv(i, wrt_strategy));
+      else if (totalRegret > 0.0) {
+	double x = 0.0;
+	for (int st = 1; st <= numStrategies; st++) {
+	  x += (regrets[st] - totalRegret * v[offset + st]) * derivs(st, col);
+	}
+	d[col] += 2.0 * x;
       }
     }
-    if (i == i1)  {
-      x += 100.0 * (psum - 1.0);
-    }
+    offset += numStrategies;
   }
-  if (p[wrt_strategy] < 0.0) {
-    x += p[wrt_strategy];
-  }
-  return 2.0 * x;
-}
-
-bool 
-StrategicLyapunovFunction::Gradient(const Vector<double> &v, Vector<double> &d) const
-{
-  static_cast<Vector<double> &>(m_profile).operator=(v);
-  for (int pl = 1, ii = 1; pl <= m_game->NumPlayers(); pl++) {
-    for (int st = 1; st <= m_game->Players()[pl]->Strategies().size(); st++) {
-      d[ii++] = LiapDerivValue(pl, st, m_profile);
+  for (int col = 1; col <= v.Length(); col++) {
+    if (v[col] < 0.0) {
+      d[col] += 2.0 * v[col];
     }
   }
   Project(d, m_game->NumStrategies());
@@ -103,10 +114,72 @@ double StrategicLyapunovFunction::Value(const Vector<double> &v) const
   return m_profile.GetLiapValue();
 }
 
+//------------------------------------------------------------------------
+//                    class SymmetricLyapunovFunction
+//------------------------------------------------------------------------
+
+//
+// The Lyapunov function restricted to profiles in which the members of
+// each class of interchangeable players play the same strategy, as a
+// function of one strategy per class.  Its gradient is that of the full
+// function, summed over the members of each class.
+//
+class SymmetricLyapunovFunction : public FunctionOnSimplices {
+public:
+  SymmetricLyapunovFunction(const MixedStrategyProfile<double> &p_start,
+			    const PlayerClasses &p_classes)
+    : m_classes(p_classes), m_function(p_start)
+  { }
+  virtual ~SymmetricLyapunovFunction() { }
+
+private:
+  const PlayerClasses &m_classes;
+  StrategicLyapunovFunction m_function;
+
+  double Value(const Vector<double> &v) const
+  { return static_cast<const Function &>(m_function).Value(m_classes.Expand(v)); }
+  bool Gradient(const Vector<double> &, Vector<double> &) const;
+};
+
+bool
+SymmetricLyapunovFunction::Gradient(const Vector<double> &v, Vector<double> &d) const
+{
+  // Each player's block of the full gradient is projected to sum to zero,
+  // so the sums over classes need no further projection
+  Vector<double> full(m_classes.FullLength());
+  static_cast<const Function &>(m_function).Gradient(m_classes.Expand(v), full);
+  d = m_classes.Fold(full);
+  return true;
+}
+
 //------------------------------------------------------------------------
 //                     class NashLiapStrategySolver
 //------------------------------------------------------------------------
 
+//
+// Minimizes the function from p_x, leaving the final point in p_x.
+// Returns true if the norm of the gradient there is small.
+//
+bool NashLiapStrategySolver::Minimize(const Function &p_function,
+				      Vector<double> &p_x) const
+{
+  ConjugatePRMinimizer minimizer(p_x.Length());
+  Vector<double> gradient(p_x.Length()), dx(p_x.Length());
+  double fval;
+  minimizer.Set(p_function, p_x, fval, gradient, .01, .0001);
+
+  for (int iter = 1; iter <= m_maxitsN; iter++) {
+    if (!minimizer.Iterate(p_function, p_x, fval, gradient, dx)) {
+      break;
+    }
+
+    if (sqrt(gradient.NormSquared()) < .001) {
+      return true;
+    }
+  }
+  return false;
+}
+
 List<MixedStrategyProfile<double> > 
 NashLiapStrategySolver::Solve(const MixedStrategyProfile<double> &p_start) const
 {
@@ -132,26 +205,26 @@ NashLiapStrategySolver::Solve(const MixedStrategyProfile<double> &p_start) const
     }
   }
 
-  StrategicLyapunovFunction F(p);
-  ConjugatePRMinimizer minimizer(p.MixedProfileLength());
-  Vector<double> gradient(p.MixedProfileLength()), dx(p.MixedProfileLength());
-  double fval;
-  minimizer.Set(F, (const Vector<double> &) p,
-		fval, gradient, .01, .0001);
-
-  for (int iter = 1; iter <= m_maxitsN; iter++) {
-    if (!minimizer.Iterate(F, (Vector<double> &) p, fval, gradient, dx)) {
-      break;
-    }
-
-    if (sqrt(gradient.NormSquared()) < .001) {
-      this->m_onEquilibrium->Render(p, "NE");
-      solutions.push_back(p);
-      break;
+  bool converged = false, reduced = false;
+  if (m_symmetric) {
+    PlayerClasses classes(p.GetGame());
+    if (!classes.IsTrivial()) {
+      // Start from the average over each class of the members' strategies
+      Vector<double> x(classes.Average(p));
+      converged = Minimize(SymmetricLyapunovFunction(p, classes), x);
+      static_cast<Vector<double> &>(p) = classes.Expand(x);
+      reduced = true;
     }
   }
+  if (!reduced) {
+    converged = Minimize(StrategicLyapunovFunction(p), p);
+  }
 
-  if (m_verbose && sqrt(gradient.NormSquared()) >= .001) {
+  if (converged) {
+    this->m_onEquilibrium->Render(p, "NE");
+    solutions.push_back(p);
+  }
+  else if (m_verbose) {
     this->m_onEquilibrium->Render(p, "end");
   }
 
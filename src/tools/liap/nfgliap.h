@@ -24,6 +24,7 @@
 #define NFGLIAP_H
 
 #include "gambit/nash.h"
+#include "gambit/function.h"
 
 using namespace Gambit;
 using namespace Gambit::Nash;
@@ -33,17 +34,24 @@ public:
   NashLiapStrategySolver(int p_maxitsN, bool p_verbose = false,
 			 shared_ptr<StrategyProfileRenderer<double> > p_onEquilibrium = 0)
     : StrategySolver<double>(p_onEquilibrium),
-      m_maxitsN(p_maxitsN), m_verbose(p_verbose)
+      m_maxitsN(p_maxitsN), m_verbose(p_verbose), m_symmetric(false)
   { }
   virtual ~NashLiapStrategySolver() { }
 
+  /// If set, only profiles in which interchangeable players (see
+  /// GameRep::GetPlayerClasses) play the same strategy are searched
+  void SetSymmetric(bool p_symmetric) { m_symmetric = p_symmetric; }
+  bool GetSymmetric(void) const { return m_symmetric; }
+
   List<MixedStrategyProfile<double> > Solve(const MixedStrategyProfile<double> &p_start) const;
   List<MixedStrategyProfile<double> > Solve(const Game &p_game) const
     { return Solve(p_game->NewMixedStrategyProfile(0.0)); }
 
 private:
   int m_maxitsN;
-  bool m_verbose;
+  bool m_verbose, m_symmetric;
+
+  bool Minimize(const Function &p_function, Vector<double> &p_x) const;
 };
 
 #endif  // NFGLIAP_H
@@ -60,6 +60,8 @@ void PrintHelp(char *progname)
   std::cerr << "  -q               quiet mode (suppresses banner)\n";
   std::cerr << "  -e               print only the terminal equilibrium\n";
   std::cerr << "                   (default is to print the entire branch)\n";
+  std::cerr << "  -y, --symmetric  trace the branch in which interchangeable players\n";
+  std::cerr << "                   play the same strategy (strategic form only)\n";
   std::cerr << "  -v, --version    print version information\n";
   exit(1);
 }
@@ -91,7 +93,7 @@ int main(int argc, char *argv[])
 {
   opterr = 0;
 
-  bool quiet = false, useStrategic = false;
+  bool quiet = false, useStrategic = false, symmetric = false;
   double maxLambda = 1000000.0;
   std::string mleFile = "";
   double maxDecel = 1.1;
@@ -104,10 +106,11 @@ int main(int argc, char *argv[])
   struct option long_options[] = {
     { "help", 0, NULL, 'h'   },
     { "version", 0, NULL, 'v'  },
+    { "symmetric", 0, NULL, 'y'  },
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "d:s:a:m:vqehSL:p:l:", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "d:s:a:m:vqehSyL:p:l:", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
@@ -135,6 +138,10 @@ int main(int argc, char *argv[])
     case 'S':
       useStrategic = true;
       break;
+    case 'y':
+      symmetric = true;
+      useStrategic = true;
+      break;
     case 'L':
       mleFile = optarg;
       break;
@@ -177,6 +184,10 @@ int main(int argc, char *argv[])
       throw UndefinedException("Computing equilibria of games with imperfect recall is not supported.");
     }
 
+    if (mleFile != "" && symmetric) {
+      throw UndefinedException("Estimation is not supported in symmetric mode.");
+    }
+
     if (mleFile != "" && (!game->IsTree() || useStrategic)) {
       MixedStrategyProfile<double> frequencies(game->NewMixedStrategyProfile(0.0));
       std::ifstream mleData(mleFile.c_str());
@@ -199,6 +210,7 @@ int main(int argc, char *argv[])
       tracer.SetStepsize(hStart);
       tracer.SetFullGraph(fullGraph);
       tracer.SetDecimals(decimals);
+      tracer.SetSymmetric(symmetric);
       if (targetLambda > 0.0) {
 	tracer.SolveAtLambda(start, std::cout, targetLambda, 1.0);
       }
@@ -26,6 +26,7 @@
 #include <fstream>
 
 #include <gambit/gambit.h>
+#include <gambit/symmetry.h>
 #include "nfglogit.h"
 
 namespace Gambit {
@@ -46,7 +47,7 @@ public:
 			   Matrix<double> &p_matrix) const;
 
 private:
-  const Game &m_game;
+  Game m_game;
 };
 
 void 
@@ -62,6 +63,7 @@ StrategicQREPathTracer::EquationSystem::GetValue(const Vector<double> &p_point,
   p_lhs = 0.0;
   for (int rowno = 0, pl = 1; pl <= m_game->NumPlayers(); pl++) {
     GamePlayer player = m_game->Players()[pl];
+    Vector<double> values = profile.GetStrategyValues(player);
     for (int st = 1; st <= player->Strategies().size(); st++) {
       rowno++;
       if (st == 1) {
@@ -75,8 +77,7 @@ StrategicQREPathTracer::EquationSystem::GetValue(const Vector<double> &p_point,
 	// This is a ratio equation
 	p_lhs[rowno] = (logprofile[player->GetStrategy(st)] - 
 			logprofile[player->GetStrategy(1)] -
-			lambda * (profile.GetPayoff(player->GetStrategy(st)) -
-				  profile.GetPayoff(player->GetStrategy(1))));
+			lambda * (values[st] - values[1]));
 
       }
     }
@@ -98,6 +99,8 @@ StrategicQREPathTracer::EquationSystem::GetJacobian(const Vector<double> &p_poin
 
   for (int rowno = 0, i = 1; i <= m_game->NumPlayers(); i++) {
     GamePlayer player = m_game->Players()[i];
+    Vector<double> values = profile.GetStrategyValues(player);
+    Matrix<double> derivs = profile.GetPayoffDerivs(player);
     for (int j = 1; j <= player->Strategies().size(); j++) {
       rowno++;
       if (j == 1) {
@@ -131,25 +134,113 @@ StrategicQREPathTracer::EquationSystem::GetJacobian(const Vector<double> &p_poin
 	    }
 	    else {
 	      p_matrix(colno, rowno) =
-		-lambda * profile[player2->GetStrategy(m)] *
-		(profile.GetPayoffDeriv(i, 
-					player->GetStrategy(j),
-					player2->GetStrategy(m)) -
-		 profile.GetPayoffDeriv(i, 
-					player->GetStrategy(1),
-					player2->GetStrategy(m)));
+		-lambda * profile[colno] * (derivs(j, colno) - derivs(1, colno));
 	    }
 	  }
 	}
 	// Fill the last column, the derivative wrt lambda
-	p_matrix(p_matrix.NumRows(), rowno) =
-	  (profile.GetPayoff(player->GetStrategy(1)) - 
-	   profile.GetPayoff(player->GetStrategy(j)));
+	p_matrix(p_matrix.NumRows(), rowno) = values[1] - values[j];
       }
     }
   }
 }
 
+//
+// The equations for profiles in which the members of each class of
+// interchangeable players play the same strategy.  The unknowns are the
+// logarithms of the probabilities of the strategies of each class, and
+// lambda; the equations are those of the first member of each class.
+// The derivative with respect to the strategy of a class is the sum of
+// those with respect to the strategies of its members.
+//
+class StrategicQREPathTracer::SymmetricEquationSystem
+  : public PathTracer::EquationSystem {
+public:
+  SymmetricEquationSystem(const Game &p_game, const PlayerClasses &p_classes)
+    : m_game(p_game), m_classes(p_classes) { }
+  virtual ~SymmetricEquationSystem() { }
+  // Compute the value of the system of equations at the specified point.
+  virtual void GetValue(const Vector<double> &p_point,
+  	                Vector<double> &p_lhs) const;
+  // Compute the Jacobian matrix at the specified point.
+  virtual void GetJacobian(const Vector<double> &p_point,
+			   Matrix<double> &p_matrix) const;
+
+private:
+  Game m_game;
+  PlayerClasses m_classes;
+
+  MixedStrategyProfile<double> GetProfile(const Vector<double> &p_point) const;
+};
+
+MixedStrategyProfile<double>
+StrategicQREPathTracer::SymmetricEquationSystem::GetProfile(const Vector<double> &p_point) const
+{
+  Vector<double> probs(m_classes.Expand(p_point));
+  MixedStrategyProfile<double> profile(m_game->NewMixedStrategyProfile(0.0));
+  for (int i = 1; i <= profile.MixedProfileLength(); i++) {
+    profile[i] = exp(probs[i]);
+  }
+  return profile;
+}
+
+void 
+StrategicQREPathTracer::SymmetricEquationSystem::GetValue(const Vector<double> &p_point,
+							  Vector<double> &p_lhs) const
+{
+  MixedStrategyProfile<double> profile(GetProfile(p_point));
+  double lambda = p_point[p_point.Length()];
+  p_lhs = 0.0;
+  for (int cls = 1; cls <= m_classes.NumClasses(); cls++) {
+    GamePlayer player = m_game->GetPlayer(m_classes.GetRepresentative(cls));
+    Vector<double> values = profile.GetStrategyValues(player);
+    int offset = m_classes.ReducedOffset(cls);
+    // The first is a sum-to-one equation, the others ratio equations
+    p_lhs[offset + 1] = -1.0;
+    for (int st = 1; st <= m_classes.NumStrategies(cls); st++) {
+      p_lhs[offset + 1] += exp(p_point[offset + st]);
+    }
+    for (int st = 2; st <= m_classes.NumStrategies(cls); st++) {
+      p_lhs[offset + st] = (p_point[offset + st] - p_point[offset + 1] -
+			    lambda * (values[st] - values[1]));
+    }
+  }
+}
+
+void
+StrategicQREPathTracer::SymmetricEquationSystem::GetJacobian(const Vector<double> &p_point,
+							     Matrix<double> &p_matrix) const
+{
+  MixedStrategyProfile<double> profile(GetProfile(p_point));
+  double lambda = p_point[p_point.Length()];
+  int length = m_classes.ReducedLength();
+
+  p_matrix = 0.0;
+
+  for (int cls = 1; cls <= m_classes.NumClasses(); cls++) {
+    GamePlayer player = m_game->GetPlayer(m_classes.GetRepresentative(cls));
+    Vector<double> values = profile.GetStrategyValues(player);
+    Matrix<double> derivs = profile.GetPayoffDerivs(player);
+    int offset = m_classes.ReducedOffset(cls);
+    // This is a sum-to-one equation
+    for (int m = 1; m <= m_classes.NumStrategies(cls); m++) {
+      p_matrix(offset + m, offset + 1) = exp(p_point[offset + m]);
+    }
+    for (int j = 2; j <= m_classes.NumStrategies(cls); j++) {
+      // This is a ratio equation
+      int rowno = offset + j;
+      Vector<double> diffs = m_classes.Fold(derivs.Row(j) - derivs.Row(1));
+      for (int colno = 1; colno <= length; colno++) {
+	p_matrix(colno, rowno) = -lambda * exp(p_point[colno]) * diffs[colno];
+      }
+      p_matrix(offset + 1, rowno) -= 1.0;
+      p_matrix(offset + j, rowno) += 1.0;
+      // Fill the last column, the derivative wrt lambda
+      p_matrix(p_matrix.NumRows(), rowno) = values[1] - values[j];
+    }
+  }
+}
+
 //----------------------------------------------------------------------------
 //               StrategicQREPathTracer: Criterion function
 //----------------------------------------------------------------------------
@@ -186,7 +277,7 @@ public:
   
 private:
   std::ostream &m_stream;
-  const Game &m_game;
+  Game m_game;
   bool m_fullGraph;
   double m_decimals;
   mutable List<LogitQREMixedStrategyProfile> m_profiles;
@@ -217,24 +308,82 @@ StrategicQREPathTracer::CallbackFunction::operator()(const Vector<double> &x,
   m_profiles.push_back(LogitQREMixedStrategyProfile(profile, x[x.Length()]));
 }
 
+//
+// Passes the points of the symmetric system on as full profiles
+//
+class StrategicQREPathTracer::SymmetricCallbackFunction
+  : public PathTracer::CallbackFunction {
+public:
+  SymmetricCallbackFunction(const PlayerClasses &p_classes,
+			    const PathTracer::CallbackFunction &p_callback)
+    : m_classes(p_classes), m_callback(p_callback) { }
+  virtual ~SymmetricCallbackFunction() { }
+
+  virtual void operator()(const Vector<double> &p_point,
+			  bool p_isTerminal) const;
+
+private:
+  const PlayerClasses &m_classes;
+  const PathTracer::CallbackFunction &m_callback;
+};
+
+void
+StrategicQREPathTracer::SymmetricCallbackFunction::operator()(const Vector<double> &p_point,
+							      bool p_isTerminal) const
+{
+  Vector<double> logprobs(m_classes.Expand(p_point));
+  Vector<double> x(logprobs.Length() + 1);
+  for (int i = 1; i <= logprobs.Length(); i++) {
+    x[i] = logprobs[i];
+  }
+  x[x.Length()] = p_point[p_point.Length()];
+  m_callback(x, p_isTerminal);
+}
+
 //----------------------------------------------------------------------------
 //               StrategicQREPathTracer: Main driver routines
 //----------------------------------------------------------------------------
 
-List<LogitQREMixedStrategyProfile>
-StrategicQREPathTracer::TraceStrategicPath(const LogitQREMixedStrategyProfile &p_start,
-					   std::ostream &p_stream,
-					   double p_maxLambda, 
-					   double p_omega) const
+void
+StrategicQREPathTracer::TraceBranch(const LogitQREMixedStrategyProfile &p_start,
+				    double p_maxLambda, double p_omega,
+				    const PathTracer::CallbackFunction &p_callback,
+				    const PathTracer::CriterionFunction &p_criterion) const
 {
+  if (m_symmetric) {
+    PlayerClasses classes(p_start.GetGame());
+    if (!classes.IsTrivial()) {
+      // Start from the average over each class of the members' strategies
+      Vector<double> start(classes.Average(p_start.GetProfile()));
+      Vector<double> x(start.Length() + 1);
+      for (int i = 1; i <= start.Length(); i++) {
+	x[i] = log(start[i]);
+      }
+      x[x.Length()] = p_start.GetLambda();
+      TracePath(SymmetricEquationSystem(p_start.GetGame(), classes),
+		x, p_maxLambda, p_omega,
+		SymmetricCallbackFunction(classes, p_callback), p_criterion);
+      return;
+    }
+  }
+
   Vector<double> x(p_start.MixedProfileLength() + 1);
   for (int i = 1; i <= p_start.MixedProfileLength(); i++) {
     x[i] = log(p_start[i]);
   }
   x[x.Length()] = p_start.GetLambda();
-  CallbackFunction func(p_stream, p_start.GetGame(), m_fullGraph, m_decimals);
   TracePath(EquationSystem(p_start.GetGame()),
-	    x, p_maxLambda, p_omega, func);
+	    x, p_maxLambda, p_omega, p_callback, p_criterion);
+}
+
+List<LogitQREMixedStrategyProfile>
+StrategicQREPathTracer::TraceStrategicPath(const LogitQREMixedStrategyProfile &p_start,
+					   std::ostream &p_stream,
+					   double p_maxLambda, 
+					   double p_omega) const
+{
+  CallbackFunction func(p_stream, p_start.GetGame(), m_fullGraph, m_decimals);
+  TraceBranch(p_start, p_maxLambda, p_omega, func, NullCriterionFunction());
   return func.GetProfiles();
 }
 
@@ -243,16 +392,9 @@ StrategicQREPathTracer::SolveAtLambda(const LogitQREMixedStrategyProfile &p_star
 				      std::ostream &p_stream,
 				      double p_targetLambda, double p_omega) const
 {
-  Vector<double> x(p_start.MixedProfileLength() + 1);
-  for (int i = 1; i <= p_start.MixedProfileLength(); i++) {
-    x[i] = log(p_start[i]);
-  }
-  x[x.Length()] = p_start.GetLambda();
   CallbackFunction func(p_stream, p_start.GetGame(), m_fullGraph, m_decimals);
-  TracePath(EquationSystem(p_start.GetGame()),
-	    x, std::max(1.0, 3.0*p_targetLambda), p_omega,
-	    func,
-	    LambdaCriterion(p_targetLambda));
+  TraceBranch(p_start, std::max(1.0, 3.0*p_targetLambda), p_omega,
+	      func, LambdaCriterion(p_targetLambda));
   return func.GetProfiles().back();
 }
 
@@ -315,7 +457,7 @@ private:
   void PrintProfile(const MixedStrategyProfile<double> &, double) const;
 
   std::ostream &m_stream;
-  const Game &m_game;
+  Game m_game;
   const Vector<double> &m_frequencies;
   bool m_fullGraph;
   double m_decimals;
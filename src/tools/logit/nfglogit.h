@@ -59,7 +59,8 @@ private:
 
 class StrategicQREPathTracer : public PathTracer {
 public:
-  StrategicQREPathTracer(void) : m_fullGraph(true), m_decimals(6)
+  StrategicQREPathTracer(void)
+    : m_fullGraph(true), m_symmetric(false), m_decimals(6)
     { }
   virtual ~StrategicQREPathTracer() { }
 
@@ -78,13 +79,27 @@ public:
   void SetDecimals(int p_decimals) { m_decimals = p_decimals; }
   int GetDecimals(void) const { return m_decimals; }
 
+  /// If set, the branch is traced in the space of profiles in which
+  /// interchangeable players (see GameRep::GetPlayerClasses) play alike
+  void SetSymmetric(bool p_symmetric) { m_symmetric = p_symmetric; }
+  bool GetSymmetric(void) const { return m_symmetric; }
+
 protected:
-  bool m_fullGraph;
+  bool m_fullGraph, m_symmetric;
   int m_decimals;
 
   class EquationSystem;
+  class SymmetricEquationSystem;
   class LambdaCriterion;
   class CallbackFunction;
+  class SymmetricCallbackFunction;
+
+  // Traces the branch from p_start, in the full or the symmetric system,
+  // passing each point to p_callback as a full profile
+  void TraceBranch(const LogitQREMixedStrategyProfile &p_start,
+		   double p_maxLambda, double p_omega,
+		   const PathTracer::CallbackFunction &p_callback,
+		   const PathTracer::CriterionFunction &p_criterion) const;
 };
 
 
@@ -23,6 +23,7 @@
 #include <unistd.h>
 #include <getopt.h>
 #include <cstdlib>
+#include <cstdio>
 #include <iostream>
 #include <cerrno>
 #include <iomanip>
@@ -71,6 +72,91 @@ RandomProfiles(const Game &p_game, int p_count, const Rational &denom)
 }
 
 
+//
+// A checkpoint file holds a header line giving the number of runs,
+// followed by the checkpoint of each run on a line of its own.
+//
+std::vector<SimpdivCheckpoint>
+ReadCheckpoints(const Game &p_game, std::istream &p_stream)
+{
+  std::string header;
+  int count;
+  if (!(p_stream >> header >> count) || header != "SIMPDIV" || count < 0) {
+    throw InvalidFileException("Checkpoint file not in a recognized format");
+  }
+  std::vector<SimpdivCheckpoint> runs(count);
+  for (int i = 0; i < count; i++) {
+    runs[i].Read(p_stream);
+    // Throws if the checkpoint does not fit the game
+    runs[i].GetProfile(p_game);
+  }
+  return runs;
+}
+
+//
+// The file is written under a temporary name and then renamed, so that
+// an interruption while writing leaves the previous checkpoints intact.
+// Returns false if the file could not be written.
+//
+bool WriteCheckpoints(const std::string &p_filename,
+		      const std::vector<SimpdivCheckpoint> &p_runs)
+{
+  std::string tempname = p_filename + ".tmp";
+  std::ofstream file(tempname.c_str());
+  file << "SIMPDIV " << p_runs.size() << std::endl;
+  for (size_t i = 0; i < p_runs.size(); i++) {
+    p_runs[i].Write(file);
+  }
+  file.close();
+  return (!file.fail() && 
+	  std::rename(tempname.c_str(), p_filename.c_str()) == 0);
+}
+
+//
+// The runs are carried out independently, each by whichever thread is
+// free to take it next, on that thread's copy of the game.  If a
+// checkpoint file is given, the progress of all the runs is saved to it
+// whenever a run completes a grid level.
+//
+void SolveRuns(const Game &p_game, std::vector<SimpdivCheckpoint> &p_runs,
+	       int p_gridResize, bool p_verbose,
+	       const std::string &p_checkpointFile)
+{
+  MixedStrategyCSVRenderer<Rational> renderer(std::cout);
+  ProfileSweep<Rational> sweep(p_game, p_runs.size(), 0.0, renderer);
+
+#pragma omp parallel for schedule(dynamic, 1)
+  for (int i = 1; i <= (int) p_runs.size(); i++) {
+    try {
+      const Game &game = sweep.GetThreadGame();
+      NashSimpdivStrategySolver algorithm(p_gridResize, 0, p_verbose,
+					  sweep.GetRecorder(i));
+      SimpdivCheckpoint run(p_runs[i-1]);
+      while (!run.IsFinished()) {
+	algorithm.Refine(game, run);
+	if (p_checkpointFile == "") continue;
+	bool written;
+#pragma omp critical(simpdiv_checkpoint)
+	{
+	  p_runs[i-1] = run;
+	  written = WriteCheckpoints(p_checkpointFile, p_runs);
+	}
+	if (!written) {
+	  throw std::runtime_error("Unable to write checkpoint file " +
+				   p_checkpointFile);
+	}
+      }
+      algorithm.Solve(game, run);
+    }
+    catch (std::runtime_error &e) {
+      sweep.Fail(e.what());
+    }
+    sweep.Finish(i);
+  }
+
+  sweep.CheckErrors();
+}
+
 void PrintBanner(std::ostream &p_stream)
 {
   p_stream << "Compute Nash equilibria using simplicial subdivision\n";
@@ -87,6 +173,8 @@ void PrintHelp(char *progname)
   std::cerr << "With no options, computes one approximate Nash equilibrium.\n\n";
 
   std::cerr << "Options:\n";
+  std::cerr << "  -c FILE          save the progress of the runs to FILE after each grid\n";
+  std::cerr << "                   level, and resume from FILE if it exists\n";
   std::cerr << "  -g MULT          granularity of grid refinement at each step (default is 2)\n";
   std::cerr << "  -h, --help       print this help message\n";
   std::cerr << "  -r DENOM         generate random starting points with denominator DENOM\n";
@@ -102,7 +190,7 @@ void PrintHelp(char *progname)
 int main(int argc, char *argv[])
 {
   opterr = 0;
-  std::string startFile;
+  std::string startFile, checkpointFile;
   bool useRandom = false;
   int randDenom = 1, gridResize = 2, stopAfter = 1;
   bool verbose = false, quiet = false;
@@ -115,10 +203,13 @@ int main(int argc, char *argv[])
     { 0,    0,    0,    0   }
   };
   int c;
-  while ((c = getopt_long(argc, argv, "g:hVvn:r:s:d:qS", long_options, &long_opt_index)) != -1) {
+  while ((c = getopt_long(argc, argv, "c:g:hVvn:r:s:d:qS", long_options, &long_opt_index)) != -1) {
     switch (c) {
     case 'v':
       PrintBanner(std::cerr); exit(1);
+    case 'c':
+      checkpointFile = optarg;
+      break;
     case 'g':
       gridResize = atoi(optarg);
       break;
@@ -175,28 +266,36 @@ int main(int argc, char *argv[])
 
   try {
     Game game = ReadGame(*input_stream);
-    List<MixedStrategyProfile<Rational> > starts;
-    if (startFile != "") {
-      std::ifstream startPoints(startFile.c_str());
-      starts = ReadProfiles(game, startPoints);
+    std::vector<SimpdivCheckpoint> runs;
+    std::ifstream checkpoints;
+    if (checkpointFile != "") {
+      checkpoints.open(checkpointFile.c_str());
     }
-    else if (useRandom) {
-      starts = RandomProfiles(game, stopAfter, randDenom);
+    if (checkpoints.is_open()) {
+      runs = ReadCheckpoints(game, checkpoints);
+      checkpoints.close();
     }
     else {
-      starts.push_back(game->NewMixedStrategyProfile(Rational(0)));
-      static_cast<Vector<Rational> &>(starts[1]) = Rational(0);
-      for (int pl = 1; pl <= game->NumPlayers(); pl++) {
-	starts[1][game->Players()[pl]->Strategies()[1]] = Rational(1);
+      List<MixedStrategyProfile<Rational> > starts;
+      if (startFile != "") {
+	std::ifstream startPoints(startFile.c_str());
+	starts = ReadProfiles(game, startPoints);
+      }
+      else if (useRandom) {
+	starts = RandomProfiles(game, stopAfter, randDenom);
+      }
+      else {
+	starts.push_back(game->NewMixedStrategyProfile(Rational(0)));
+	static_cast<Vector<Rational> &>(starts[1]) = Rational(0);
+	for (int pl = 1; pl <= game->NumPlayers(); pl++) {
+	  starts[1][game->Players()[pl]->Strategies()[1]] = Rational(1);
+	}
+      }
+      for (int i = 1; i <= starts.size(); i++) {
+	runs.push_back(SimpdivCheckpoint(starts[i]));
       }
     }
-    for (int i = 1; i <= starts.size(); i++) {
-      shared_ptr<StrategyProfileRenderer<Rational> > renderer;
-      renderer = new MixedStrategyCSVRenderer<Rational>(std::cout);
-      NashSimpdivStrategySolver algorithm(gridResize, 0, verbose,
-					  renderer);
-      algorithm.Solve(starts[i]);
-    }
+    SolveRuns(game, runs, gridResize, verbose, checkpointFile);
     return 0;
   }
   catch (std::runtime_error &e) {